@@ -0,0 +1,224 @@
+/***********************************************************************************
+ *                                                                                 *
+ * Copyright. (C) 2023 Mobirix.                                                    *
+ * Website: https://mobirix.com													   *
+ *                                                                                 *
+ ***********************************************************************************/
+
+
+#include "Data/MBakeTablesCommandlet.h"
+
+#include "Data/MBakedTable.h"
+#include "Data/MDataManager.h"
+#include "Data/Base/MdataStruct.h"
+#include "HAL/FileManager.h"
+#include "HAL/PlatformMemory.h"
+#include "Misc/Paths.h"
+#include "Synthesis/MSynthesisPlanner.h"
+#include "Synthesis/MSynthesisProviders.h"
+
+DEFINE_LOG_CATEGORY_STATIC(LogMBakeTables, Log, All);
+
+namespace MBakeTables
+{
+	// 폰 데이터 크기의 가상 레코드
+	struct FBenchmarkRecord
+	{
+		int TID = 0;
+		int Values[15] = {};
+
+		static constexpr uint32 BakedSchemaVersion = 1;
+	};
+
+	bool BakeSynthesisRecipes(const FString& InOutDir)
+	{
+		TArray<TPair<int, FMSynthesisRecipe>> Records;
+		for (const TPair<int, const FMSynthesisData*> Pair : MDATAMGR->GetSynthesisMap())
+		{
+			if (Pair.Value)
+			{
+				Records.Emplace(Pair.Key, FMSynthesisRecipe::FromData(Pair.Key, *Pair.Value));
+			}
+		}
+
+		TMDenseTIDTable<FMSynthesisRecipe> Table;
+		Table.Build(MoveTemp(Records));
+
+		const FString Path = FMDataManagerSynthesisProvider::GetBakedRecipePath(InOutDir);
+		const bool bSaved = TMBakedTable<FMSynthesisRecipe>::Write(Path, FMSynthesisRecipe::BakedSchemaVersion, Table);
+
+		UE_LOG(LogMBakeTables, Display, TEXT("%s %s (%d records)"), bSaved ? TEXT("Baked") : TEXT("Failed"), *Path, Table.Num());
+		return bSaved;
+	}
+
+	int64 GetUsedPhysical()
+	{
+		return static_cast<int64>(FPlatformMemory::GetStats().UsedPhysical);
+	}
+
+	// 런타임과 같은 경로로 합성 조회 테이블을 만든다. 기존 방식은 MDATAMGR 레코드 변환, 베이크는 파일 매핑이다.
+	bool RunRecipeBenchmark(const FString& InOutDir, const int InIterations)
+	{
+		if (BakeSynthesisRecipes(InOutDir) == false)
+		{
+			return false;
+		}
+
+		const FString Path = FMDataManagerSynthesisProvider::GetBakedRecipePath(InOutDir);
+		const int Iterations = FMath::Max(InIterations, 1);
+
+		FMDataManagerSynthesisProvider Converted;
+		int64 Resident = GetUsedPhysical();
+		double Start = FPlatformTime::Seconds();
+		for (int i = 0; i < Iterations; i++)
+		{
+			Converted.BuildRecipesFromDataManager();
+		}
+		const double ConvertSeconds = (FPlatformTime::Seconds() - Start) / Iterations;
+		const int64 ConvertResident = GetUsedPhysical() - Resident;
+
+		bool bLoaded = true;
+		for (const bool bVerifyCrc : { false, true })
+		{
+			FMDataManagerSynthesisProvider Baked;
+			FString Error;
+
+			Resident = GetUsedPhysical();
+			Start = FPlatformTime::Seconds();
+			for (int i = 0; i < Iterations && Error.IsEmpty(); i++)
+			{
+				Baked.BuildRecipesFromBaked(Path, Error, bVerifyCrc);
+			}
+			const double BakedSeconds = (FPlatformTime::Seconds() - Start) / Iterations;
+			const int64 BakedResident = GetUsedPhysical() - Resident;
+
+			if (Error.IsEmpty() == false)
+			{
+				UE_LOG(LogMBakeTables, Error, TEXT("%s"), *Error);
+				bLoaded = false;
+				continue;
+			}
+
+			const bool bSame = Baked.GetRecipes().GetTIDs() == Converted.GetRecipes().GetTIDs();
+			bLoaded &= bSame;
+
+			UE_LOG(LogMBakeTables, Display, TEXT("Recipes %s : %.3f ms, resident %+lld bytes, heap %llu bytes, Same=%d"), bVerifyCrc ? TEXT("baked+crc") : TEXT("baked    "), BakedSeconds * 1000.0, BakedResident, static_cast<uint64>(Baked.GetAllocatedSize()), bSame ? 1 : 0);
+		}
+
+		UE_LOG(LogMBakeTables, Display, TEXT("Recipes datamgr   : %.3f ms, resident %+lld bytes, heap %llu bytes (%d records)"), ConvertSeconds * 1000.0, ConvertResident, static_cast<uint64>(Converted.GetAllocatedSize()), Converted.GetRecipes().Num());
+
+		return bLoaded;
+	}
+
+	// 여러 테이블을 코어마다 나눠 여는 시간. 가상 레코드라 비교 대상 없이 매핑 비용만 본다.
+	bool RunMappingBenchmark(const FString& InOutDir, const int InRecordCount, const int InTableCount)
+	{
+		TArray<FString> Paths;
+		for (int Table = 0; Table < InTableCount; Table++)
+		{
+			TArray<TPair<int, FBenchmarkRecord>> Records;
+			Records.Reserve(InRecordCount);
+			for (int i = 0; i < InRecordCount; i++)
+			{
+				FBenchmarkRecord Record;
+				Record.TID = 100000 * (Table + 1) + i;
+				Record.Values[0] = i;
+				Records.Emplace(Record.TID, Record);
+			}
+
+			TMDenseTIDTable<FBenchmarkRecord> DenseTable;
+			DenseTable.Build(MoveTemp(Records));
+
+			FString& Path = Paths.Emplace_GetRef(FPaths::Combine(InOutDir, FString::Printf(TEXT("Benchmark%d.mbt"), Table)));
+			TMBakedTable<FBenchmarkRecord>::Write(Path, FBenchmarkRecord::BakedSchemaVersion, DenseTable);
+		}
+
+		bool bResult = true;
+		for (const bool bVerifyCrc : { false, true })
+		{
+			TArray<TMBakedTable<FBenchmarkRecord>> Tables;
+			Tables.SetNum(InTableCount);
+
+			TArray<FMBakedTableLoadRequest> Requests;
+			for (int Table = 0; Table < InTableCount; Table++)
+			{
+				FMBakedTableLoadRequest& Request = Requests.AddDefaulted_GetRef();
+				Request.Path = Paths[Table];
+				Request.SchemaVersion = FBenchmarkRecord::BakedSchemaVersion;
+				Request.RecordSize = sizeof(FBenchmarkRecord);
+				Request.File = &Tables[Table].GetFile();
+				Request.bVerifyCrc = bVerifyCrc;
+			}
+
+			const int64 Resident = GetUsedPhysical();
+			const double Start = FPlatformTime::Seconds();
+			const bool bLoaded = FMBakedTableLoader::OpenAll(Requests);
+			const double MapSeconds = FPlatformTime::Seconds() - Start;
+			const int64 MapResident = GetUsedPhysical() - Resident;
+
+			int64 MappedBytes = 0;
+			for (const FMBakedTableLoadRequest& Request : Requests)
+			{
+				if (Request.Error.IsEmpty() == false)
+				{
+					UE_LOG(LogMBakeTables, Error, TEXT("%s"), *Request.Error);
+				}
+
+				MappedBytes += Request.File->GetFileSize();
+			}
+
+			int Missing = 0;
+			for (int Table = 0; Table < InTableCount; Table++)
+			{
+				for (int i = 0; i < InRecordCount; i += 997)
+				{
+					const FBenchmarkRecord* Record = Tables[Table].Find(100000 * (Table + 1) + i);
+					Missing += (Record == nullptr || Record->Values[0] != i) ? 1 : 0;
+				}
+			}
+
+			UE_LOG(LogMBakeTables, Display, TEXT("Mapped %s : Tables=%d Records=%d %.2f ms, mapped %lld bytes, resident %+lld bytes, Missing=%d"), bVerifyCrc ? TEXT("crc") : TEXT("   "), InTableCount, InRecordCount, MapSeconds * 1000.0, MappedBytes, MapResident, Missing);
+
+			bResult &= bLoaded && Missing == 0;
+		}
+
+		return bResult;
+	}
+}
+
+UMBakeTablesCommandlet::UMBakeTablesCommandlet()
+{
+	IsClient = false;
+	IsServer = false;
+	IsEditor = false;
+	LogToConsole = true;
+}
+
+int32 UMBakeTablesCommandlet::Main(const FString& Params)
+{
+	if (FParse::Param(*Params, TEXT("Benchmark")))
+	{
+		// 배포 콘텐츠와 실제 베이크 파일은 건드리지 않도록 Saved 아래 임시 폴더에 굽고 끝나면 지운다.
+		const FString BenchmarkDir = FPaths::Combine(FPaths::ProjectSavedDir(), TEXT("BakedTablesBenchmark"));
+
+		int Iterations = 10;
+		int RecordCount = 100000;
+		int TableCount = 6;
+		FParse::Value(*Params, TEXT("Iterations="), Iterations);
+		FParse::Value(*Params, TEXT("Records="), RecordCount);
+		FParse::Value(*Params, TEXT("Tables="), TableCount);
+
+		const bool bRecipes = MBakeTables::RunRecipeBenchmark(BenchmarkDir, Iterations);
+		const bool bMapping = MBakeTables::RunMappingBenchmark(BenchmarkDir, RecordCount, TableCount);
+
+		IFileManager::Get().DeleteDirectory(*BenchmarkDir, false, true);
+
+		return bRecipes && bMapping ? 0 : 1;
+	}
+
+	// 런타임은 Content/BakedTables에서 찾으므로 기본으로 그 자리에 굽는다.
+	FString OutDir = FPaths::Combine(FPaths::ProjectContentDir(), TEXT("BakedTables"));
+	FParse::Value(*Params, TEXT("Out="), OutDir);
+
+	return MBakeTables::BakeSynthesisRecipes(OutDir) ? 0 : 1;
+}
@@ -0,0 +1,29 @@
+/***********************************************************************************
+ *                                                                                 *
+ * Copyright. (C) 2023 Mobirix.                                                    *
+ * Website: https://mobirix.com													   *
+ *                                                                                 *
+ ***********************************************************************************/
+
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Commandlets/Commandlet.h"
+#include "MBakeTablesCommandlet.generated.h"
+
+// 데이터 테이블을 메모리 매핑용 바이너리로 굽는 커맨드렛.
+// -Benchmark를 주면 합성 테이블을 데이터 매니저에서 옮기는 기존 방식과 베이크 파일 매핑의 시간/상주 메모리를 비교하고,
+// 가상 테이블 여러 개를 병렬로 매핑하는 시간을 CRC 검사 여부별로 잰다. 벤치마크 파일은 Saved 아래에 만들고 끝나면 지운다.
+// 예) -run=MBakeTables -Out=Content/BakedTables
+// 예) -run=MBakeTables -Benchmark -Iterations=10 -Records=100000 -Tables=6
+UCLASS()
+class MRPG_API UMBakeTablesCommandlet : public UCommandlet
+{
+	GENERATED_BODY()
+
+public:
+	UMBakeTablesCommandlet();
+
+	virtual int32 Main(const FString& Params) override;
+};
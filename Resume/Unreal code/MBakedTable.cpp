@@ -0,0 +1,226 @@
+/***********************************************************************************
+ *                                                                                 *
+ * Copyright. (C) 2023 Mobirix.                                                    *
+ * Website: https://mobirix.com													   *
+ *                                                                                 *
+ ***********************************************************************************/
+
+
+#include "Data/MBakedTable.h"
+
+#include "Algo/BinarySearch.h"
+#include "Async/MappedFileHandle.h"
+#include "Async/ParallelFor.h"
+#include "HAL/PlatformFileManager.h"
+#include "Misc/FileHelper.h"
+
+FMBakedTableFile::FMBakedTableFile() = default;
+
+FMBakedTableFile::~FMBakedTableFile()
+{
+	Close();
+}
+
+int64 FMBakedTableFile::GetRecordsOffset(const int InRecordCount)
+{
+	return Align(sizeof(FMBakedTableHeader) + static_cast<int64>(InRecordCount) * sizeof(int32), 16);
+}
+
+bool FMBakedTableFile::Open(const FString& InPath, const uint32 InSchemaVersion, const uint32 InRecordSize, FString& OutError, const bool bVerifyCrc)
+{
+	Close();
+
+	IPlatformFile& PlatformFile = FPlatformFileManager::Get().GetPlatformFile();
+
+	Handle.Reset(PlatformFile.OpenMapped(*InPath));
+	if (Handle.IsValid())
+	{
+		Region.Reset(Handle->MapRegion(0, Handle->GetFileSize()));
+	}
+
+	if (Region.IsValid())
+	{
+		Data = Region->GetMappedPtr();
+		Size = Region->GetMappedSize();
+	}
+	else
+	{
+		Region.Reset();
+		Handle.Reset();
+
+		if (FFileHelper::LoadFileToArray(Fallback, *InPath) == false)
+		{
+			OutError = FString::Printf(TEXT("cannot read %s"), *InPath);
+			return false;
+		}
+
+		Data = Fallback.GetData();
+		Size = Fallback.Num();
+	}
+
+	auto Fail = [ this, &OutError, &InPath ] (const TCHAR* InReason)
+	{
+		OutError = FString::Printf(TEXT("%s: %s"), *InPath, InReason);
+		Close();
+		return false;
+	};
+
+	if (Data == nullptr || Size < static_cast<int64>(sizeof(FMBakedTableHeader)))
+	{
+		return Fail(TEXT("truncated header"));
+	}
+
+	Header = reinterpret_cast<const FMBakedTableHeader*>(Data);
+	if (Header->Magic != MBAKED_TABLE_MAGIC)
+	{
+		return Fail(TEXT("bad magic"));
+	}
+
+	if (Header->FormatVersion != MBAKED_TABLE_FORMAT_VERSION || Header->SchemaVersion != InSchemaVersion)
+	{
+		return Fail(TEXT("version mismatch"));
+	}
+
+	if (Header->RecordSize != InRecordSize || Header->RecordCount < 0 || Header->SlotCount < 0)
+	{
+		return Fail(TEXT("layout mismatch"));
+	}
+
+	const int64 RecordsOffset = GetRecordsOffset(Header->RecordCount);
+	const int64 SlotsOffset = Align(RecordsOffset + static_cast<int64>(Header->RecordCount) * Header->RecordSize, 4);
+	const int64 ExpectedSize = SlotsOffset + static_cast<int64>(Header->SlotCount) * sizeof(int32);
+	if (Size != ExpectedSize)
+	{
+		return Fail(TEXT("size mismatch"));
+	}
+
+	if (bVerifyCrc && FCrc::MemCrc32(Data + sizeof(FMBakedTableHeader), Size - sizeof(FMBakedTableHeader)) != Header->PayloadCrc)
+	{
+		return Fail(TEXT("checksum mismatch"));
+	}
+
+	TIDs = reinterpret_cast<const int32*>(Data + sizeof(FMBakedTableHeader));
+	Records = Data + RecordsOffset;
+	Slots = Header->SlotCount > 0 ? reinterpret_cast<const int32*>(Data + SlotsOffset) : nullptr;
+
+	// CRC를 끄더라도 찾기가 배열 밖을 읽지 않도록 TID 순서와 슬롯 값은 항상 검사한다.
+	for (int i = 1; i < Header->RecordCount; i++)
+	{
+		if (TIDs[i - 1] >= TIDs[i])
+		{
+			return Fail(TEXT("unsorted TIDs"));
+		}
+	}
+
+	for (int i = 0; i < Header->SlotCount; i++)
+	{
+		const int32 Index = Slots[i];
+		if (Index == INDEX_NONE)
+		{
+			continue;
+		}
+
+		if (Index < 0 || Index >= Header->RecordCount || static_cast<int64>(TIDs[Index]) != static_cast<int64>(Header->BaseTID) + i)
+		{
+			return Fail(TEXT("bad slot"));
+		}
+	}
+
+	return true;
+}
+
+void FMBakedTableFile::Close()
+{
+	Region.Reset();
+	Handle.Reset();
+	Fallback.Empty();
+
+	Data = nullptr;
+	Size = 0;
+	Header = nullptr;
+	TIDs = nullptr;
+	Records = nullptr;
+	Slots = nullptr;
+}
+
+int FMBakedTableFile::FindIndex(const int InTID) const
+{
+	if (Header == nullptr)
+	{
+		return INDEX_NONE;
+	}
+
+	if (Slots)
+	{
+		const uint32 Offset = static_cast<uint32>(InTID) - static_cast<uint32>(Header->BaseTID);
+		return Offset < static_cast<uint32>(Header->SlotCount) ? Slots[Offset] : INDEX_NONE;
+	}
+
+	return Algo::BinarySearch(TArrayView<const int32>(TIDs, Header->RecordCount), InTID);
+}
+
+const uint8* FMBakedTableFile::GetRecord(const int InIndex) const
+{
+	if (Header == nullptr || InIndex < 0 || InIndex >= Header->RecordCount)
+	{
+		return nullptr;
+	}
+
+	return Records + static_cast<int64>(InIndex) * Header->RecordSize;
+}
+
+bool FMBakedTableFile::Write(const FString& InPath, const uint32 InSchemaVersion, const uint32 InRecordSize, const TArray<int>& InTIDs, const void* InRecords, const int InBaseTID, const TArray<int32>& InSlots)
+{
+	const int64 RecordsOffset = GetRecordsOffset(InTIDs.Num());
+	const int64 SlotsOffset = Align(RecordsOffset + static_cast<int64>(InTIDs.Num()) * InRecordSize, 4);
+
+	TArray64<uint8> Bytes;
+	Bytes.SetNumZeroed(SlotsOffset + static_cast<int64>(InSlots.Num()) * sizeof(int32));
+
+	FMBakedTableHeader& Header = *reinterpret_cast<FMBakedTableHeader*>(Bytes.GetData());
+	Header = FMBakedTableHeader();
+	Header.SchemaVersion = InSchemaVersion;
+	Header.RecordSize = InRecordSize;
+	Header.RecordCount = InTIDs.Num();
+	Header.BaseTID = InBaseTID;
+	Header.SlotCount = InSlots.Num();
+
+	FMemory::Memcpy(Bytes.GetData() + sizeof(FMBakedTableHeader), InTIDs.GetData(), InTIDs.Num() * sizeof(int32));
+	FMemory::Memcpy(Bytes.GetData() + RecordsOffset, InRecords, static_cast<int64>(InTIDs.Num()) * InRecordSize);
+	FMemory::Memcpy(Bytes.GetData() + SlotsOffset, InSlots.GetData(), InSlots.Num() * sizeof(int32));
+
+	Header.PayloadCrc = FCrc::MemCrc32(Bytes.GetData() + sizeof(FMBakedTableHeader), Bytes.Num() - sizeof(FMBakedTableHeader));
+
+	return FFileHelper::SaveArrayToFile(Bytes, *InPath);
+}
+
+bool FMBakedTableLoader::OpenAll(TArray<FMBakedTableLoadRequest>& InOutRequests)
+{
+	// 테이블마다 매핑과 검증이 독립적이라 그대로 나눠 처리한다.
+	ParallelFor(InOutRequests.Num(), [ &InOutRequests ] (const int32 InIndex)
+	{
+		FMBakedTableLoadRequest& Request = InOutRequests[InIndex];
+		const double Start = FPlatformTime::Seconds();
+
+		if (Request.File == nullptr)
+		{
+			Request.Error = TEXT("no file");
+		}
+		else
+		{
+			Request.File->Open(Request.Path, Request.SchemaVersion, Request.RecordSize, Request.Error, Request.bVerifyCrc);
+		}
+
+		Request.Seconds = FPlatformTime::Seconds() - Start;
+	});
+
+	for (const FMBakedTableLoadRequest& Request : InOutRequests)
+	{
+		if (Request.File == nullptr || Request.File->IsOpen() == false)
+		{
+			return false;
+		}
+	}
+
+	return true;
+}
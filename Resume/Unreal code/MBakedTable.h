@@ -0,0 +1,161 @@
+/***********************************************************************************
+ *                                                                                 *
+ * Copyright. (C) 2023 Mobirix.                                                    *
+ * Website: https://mobirix.com													   *
+ *                                                                                 *
+ ***********************************************************************************/
+
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Data/MDenseTIDTable.h"
+#include <type_traits>
+
+class IMappedFileHandle;
+class IMappedFileRegion;
+
+#define MBAKED_TABLE_MAGIC 0x4C54424D	// 'MBTL'
+#define MBAKED_TABLE_FORMAT_VERSION 1
+
+// 베이크된 테이블 파일 헤더. 뒤로 TID 배열, 레코드 배열(16바이트 정렬), 오프셋 배열이 이어진다.
+struct FMBakedTableHeader
+{
+	uint32 Magic = MBAKED_TABLE_MAGIC;
+
+	uint32 FormatVersion = MBAKED_TABLE_FORMAT_VERSION;
+
+	// 레코드 구조가 바뀌면 올리는 값
+	uint32 SchemaVersion = 0;
+
+	uint32 RecordSize = 0;
+
+	int32 RecordCount = 0;
+
+	int32 BaseTID = 0;
+
+	// 0이면 TID 배열 이진 탐색으로 찾는다.
+	int32 SlotCount = 0;
+
+	// 헤더 뒤 전체 내용의 CRC
+	uint32 PayloadCrc = 0;
+};
+static_assert(sizeof(FMBakedTableHeader) == 32, "FMBakedTableHeader layout changed");
+
+// 베이크된 테이블 파일 하나. 파일을 메모리에 매핑하고, 레코드는 복사하지 않고 매핑된 자리에서 읽는다.
+// 매핑을 지원하지 않는 플랫폼에서는 파일 전체를 읽어 같은 방식으로 쓴다.
+class MRPG_API FMBakedTableFile
+{
+public:
+	FMBakedTableFile();
+	~FMBakedTableFile();
+
+	// 헤더, 파일 크기, TID 순서와 슬롯 범위는 항상 검사한다. 페이로드 CRC는 레코드 페이지까지 모두 읽어 올리므로 bVerifyCrc일 때만 검사한다.
+	bool Open(const FString& InPath, const uint32 InSchemaVersion, const uint32 InRecordSize, FString& OutError, const bool bVerifyCrc = false);
+
+	void Close();
+
+	bool IsOpen() const { return Data != nullptr; }
+
+	int Num() const { return Header ? Header->RecordCount : 0; }
+
+	int FindIndex(const int InTID) const;
+
+	const uint8* GetRecord(const int InIndex) const;
+
+	const int32* GetTIDs() const { return TIDs; }
+
+	int GetBaseTID() const { return Header ? Header->BaseTID : 0; }
+
+	TArrayView<const int32> GetSlots() const { return Slots ? MakeArrayView(Slots, Header->SlotCount) : TArrayView<const int32>(); }
+
+	int64 GetFileSize() const { return Size; }
+
+	// 매핑에 실패해 힙으로 읽은 크기
+	SIZE_T GetAllocatedSize() const { return Fallback.GetAllocatedSize(); }
+
+	static bool Write(const FString& InPath, const uint32 InSchemaVersion, const uint32 InRecordSize, const TArray<int>& InTIDs, const void* InRecords, const int InBaseTID, const TArray<int32>& InSlots);
+
+private:
+	static int64 GetRecordsOffset(const int InRecordCount);
+
+	TUniquePtr<IMappedFileHandle> Handle;
+
+	TUniquePtr<IMappedFileRegion> Region;
+
+	TArray64<uint8> Fallback;
+
+	const uint8* Data = nullptr;
+
+	int64 Size = 0;
+
+	const FMBakedTableHeader* Header = nullptr;
+
+	const int32* TIDs = nullptr;
+
+	const uint8* Records = nullptr;
+
+	const int32* Slots = nullptr;
+};
+
+// 여러 테이블을 코어마다 나눠 매핑하고 검증한다.
+struct MRPG_API FMBakedTableLoadRequest
+{
+	FString Path;
+
+	uint32 SchemaVersion = 0;
+
+	uint32 RecordSize = 0;
+
+	FMBakedTableFile* File = nullptr;
+
+	bool bVerifyCrc = false;
+
+	FString Error;
+
+	double Seconds = 0.0;
+};
+
+class MRPG_API FMBakedTableLoader
+{
+public:
+	// 모두 열었으면 true. 실패한 요청은 Error에 이유가 남는다.
+	static bool OpenAll(TArray<FMBakedTableLoadRequest>& InOutRequests);
+};
+
+template <typename RecordType>
+class TMBakedTable
+{
+	static_assert(std::is_trivially_copyable_v<RecordType>, "Baked records are used in place and must be trivially copyable");
+
+public:
+	bool Open(const FString& InPath, const uint32 InSchemaVersion, FString& OutError, const bool bVerifyCrc = false)
+	{
+		return File.Open(InPath, InSchemaVersion, sizeof(RecordType), OutError, bVerifyCrc);
+	}
+
+	const RecordType* Find(const int InTID) const
+	{
+		const int Index = File.FindIndex(InTID);
+		return Index != INDEX_NONE ? reinterpret_cast<const RecordType*>(File.GetRecord(Index)) : nullptr;
+	}
+
+	int Num() const { return File.Num(); }
+
+	// 매핑된 레코드를 정렬이나 변환 없이 그대로 옮긴다.
+	void CopyTo(TMDenseTIDTable<RecordType>& OutTable) const
+	{
+		const int Count = File.Num();
+		OutTable.Assign(MakeArrayView(File.GetTIDs(), Count), MakeArrayView(reinterpret_cast<const RecordType*>(File.GetRecord(0)), Count), File.GetBaseTID(), File.GetSlots());
+	}
+
+	FMBakedTableFile& GetFile() { return File; }
+
+	static bool Write(const FString& InPath, const uint32 InSchemaVersion, const TMDenseTIDTable<RecordType>& InTable)
+	{
+		return FMBakedTableFile::Write(InPath, InSchemaVersion, sizeof(RecordType), InTable.GetTIDs(), InTable.GetRecords().GetData(), InTable.GetBaseTID(), InTable.GetSlots());
+	}
+
+private:
+	FMBakedTableFile File;
+};
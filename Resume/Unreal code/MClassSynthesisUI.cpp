@@ -1,933 +1,1800 @@
-/***********************************************************************************
- *                                                                                 *
- * Copyright. (C) 2023 Mobirix.                                                    *
- * Website: https://mobirix.com													   *
- *                                                                                 *
- ***********************************************************************************/
-
-#include "UI/Class/MClassSynthesisUI.h"
-
-#include "Components/Button.h"
-#include "Components/Image.h"
-#include "Components/ListView.h"
-#include "Components/TextBlock.h"
-#include "Data/MDataManager.h"
-#include "Data/Base/MDataEnumString.h"
-#include "Data/Base/MdataStruct.h"
-#include "Util/MGlobalFunctionLib.h"
-#include "Network/MNetworkManager.h"
-#include "Network/Data/MNetworkDataManager.h"
-#include "UI/MUIManager.h"
-#include "UI/Class/MClassTabUI.h"
-#include "UI/Common/MCharacterListUI.h"
-#include "UI/Common/MCommonBtn.h"
-#include "UI/Common/Icon/MPawnIconUI.h"
-#include "UI/Common/PressButton/MCategoryTabEntryUI.h"
-#include "UI/Gacha/MGachaUI.h"
-#include "Util/MStringHelper.h"
-
-#define MAX_SYNTHESIS_COUNT 11
-
-void UMClassSynthesisUI::NativeConstruct()
-{
-	Super::NativeConstruct();
-
-	if (const UMBaseUIWidget* Menubar = Slot->GetTypedOuter<UMClassTabUI>())
-	{
-		if (const FMUILoadData* LoadData = Menubar->GetUILoadInfo())
-		{
-			if (LoadData->ID == "ClassUI")
-			{
-				PawnType = EMPawnType::Hero;
-			}
-			else if (LoadData->ID == "PetUI")
-			{
-				PawnType = EMPawnType::Pet;
-			}
-			else if (LoadData->ID == "VehicleUI")
-			{
-				PawnType = EMPawnType::Vehicle;
-			}
-		}
-	}
-
-	if (GradeListView)
-	{
-		GradeListView->OnItemSelectionChanged().AddUObject(this, &UMClassSynthesisUI::OnClickedGrade);
-		GradeListView->SetScrollbarVisibility(ESlateVisibility::Collapsed);
-	}
-
-	if (ButtonAuto)
-	{
-		ButtonAuto->SetCommonBtn(EMCommonBtnType::Normal, MStringHelper::FindLocTableText(EMLocTableType::UI, TEXT("Common_UI_Automatic")));
-		ButtonAuto->DelegateCommonBtnClickedEvent.BindUObject(this, &UMClassSynthesisUI::OnClickedAutoButton);
-	}
-
-	if (ButtonClear)
-	{
-		ButtonClear->DelegateCommonBtnClickedEvent.BindUObject(this, &UMClassSynthesisUI::OnClockedClearButton);
-	}
-
-	if (ButtonSynthesis)
-	{
-		ButtonSynthesis->SetCommonBtn(EMCommonBtnType::Normal, MStringHelper::FindLocTableText(EMLocTableType::UI, TEXT("Synthesis_UI_Synthesis")));
-		ButtonSynthesis->DelegateCommonBtnClickedEvent.BindUObject(this, &UMClassSynthesisUI::OnClickedSynthesisButton);
-	}
-
-	MNETMGR->OnRecvCombineAck.AddUObject(this, &UMClassSynthesisUI::RecvCombineAck);
-
-	if (CharacterList)
-	{
-		CharacterList->HideRedDot(true);
-		CharacterList->HideSelection(true);
-		CharacterList->HideEquipMark(true);
-
-		EMCharacterListUIType Type = EMCharacterListUIType::Class;
-		if (PawnType == EMPawnType::Pet)
-		{
-			Type = EMCharacterListUIType::Pet;
-		}
-		else if (PawnType == EMPawnType::Vehicle)
-		{
-			Type = EMCharacterListUIType::Vehicle;
-		}
-
-		CharacterList->SetCharacterListUIType(Type);
-
-		CharacterList->OnClickedCharacterListItem.BindUObject(this, &UMClassSynthesisUI::OnClickedCharacterListItem);
-
-		CharacterList->SetListFilter([ ] (const int InTID)
-		{
-			return MNETDATAMGR->GetNetPawnHaveCount(InTID) > 1;
-		});
-
-		CharacterList->SetDimmedFilter([ this ] (const int InTID)
-		{
-			return (MNETDATAMGR->GetNetPawnHaveCount(InTID) - this->GetIngredientCountOfTID(InTID)) <= 1;
-		});
-
-		CharacterList->SetVisibleCharacterCount(true);
-
-		CharacterList->HideExploringMark(true);
-	}
-
-	SynthesisSlots.Emplace(SynthesisSlot1);
-	SynthesisSlots.Emplace(SynthesisSlot2);
-	SynthesisSlots.Emplace(SynthesisSlot3);
-	SynthesisSlots.Emplace(SynthesisSlot4);
-
-	for (int i = 0 ; i < SynthesisSlots.Num(); i++)
-	{
-		FMClassSynthesisSlot SynthesisSlot;
-		SynthesisSlot.Index = i;
-		IngredientSlots.Emplace(SynthesisSlot);
-	}
-
-	SlotButtons.Emplace(ButtonSlot1);
-	SlotButtons.Emplace(ButtonSlot2);
-	SlotButtons.Emplace(ButtonSlot3);
-	SlotButtons.Emplace(ButtonSlot4);
-
-	ButtonSlot1->OnClicked.AddDynamic(this, &UMClassSynthesisUI::OnClickedSlot1);
-	ButtonSlot2->OnClicked.AddDynamic(this, &UMClassSynthesisUI::OnClickedSlot2);
-	ButtonSlot3->OnClicked.AddDynamic(this, &UMClassSynthesisUI::OnClickedSlot3);
-	ButtonSlot4->OnClicked.AddDynamic(this, &UMClassSynthesisUI::OnClickedSlot4);
-
-	MUIMGR->DelegateGachaAgainSynthesis.Unbind();
-	MUIMGR->DelegateGachaAgainSynthesis.BindUObject(this, &UMClassSynthesisUI::OnClickedPopupGachaAgainButton);
-
-	CreateGradeTab();
-	ClearIngredient();
-	SettingSlotCount();
-	UpdateSlot();
-	UpdateCharacterCountAll();
-	UpdateSynthesisCount();
-	UpdateNoIngredientText();
-	UpdateSynthesisButton();
-	UpdateProbability();
-	UpdateCanSynthesisImage();
-
-	if (GradeListView)
-	{
-		GradeListView->SetSelectedIndex(0);
-	}
-}
-
-void UMClassSynthesisUI::NativeDestruct()
-{
-	if (ButtonAuto)
-	{
-		ButtonAuto->DelegateCommonBtnClickedEvent.Unbind();
-	}
-
-	if (ButtonClear)
-	{
-		ButtonClear->DelegateCommonBtnClickedEvent.Unbind();
-	}
-
-	if (ButtonSynthesis)
-	{
-		ButtonSynthesis->DelegateCommonBtnClickedEvent.Unbind();
-	}
-
-	if (CharacterList)
-	{
-		CharacterList->OnClickedCharacterListItem.Unbind();
-		CharacterList->RemoveDimmedFilter();
-		CharacterList->RemoveListFilter();
-	}
-
-	for (UButton* Button : SlotButtons)
-	{
-		if (Button)
-		{
-			Button->OnClicked.RemoveAll(this);
-		}
-	}
-
-	MNETMGR->OnRecvCombineAck.RemoveAll(this);
-
-	MUIMGR->DelegateGachaAgainSynthesis.Unbind();
-
-	Super::NativeDestruct();
-}
-
-void UMClassSynthesisUI::ReOpenUI(ESlateVisibility InVisibility)
-{
-	Super::ReOpenUI(InVisibility);
-
-	if (GradeListView)
-	{
-		GradeListView->SetSelectedIndex(0);
-	}
-
-	ClearIngredient();
-}
-
-void UMClassSynthesisUI::OnClickedAutoButton(EMCommonBtnType ButtonType)
-{
-	if (AutoPushIngredient() == false)
-	{
-		MUIMGR->SetGameToastMessage("347");
-		return;
-	}
-	
-	UpdateNoIngredientText();
-}
-
-void UMClassSynthesisUI::OnClockedClearButton(EMCommonBtnType ButtonType)
-{
-	ClearIngredient();
-	UpdateNoIngredientText();
-}
-
-void UMClassSynthesisUI::OnClickedSynthesisButton(EMCommonBtnType ButtonType)
-{
-	if (CanSynthesis() == false)
-	{
-		MUIMGR->SetGameToastMessage("348");
-		return;
-	}
-
-	FCombineReqT Req;
-	TMap<int, int> Ingredients;
-	int SynthesisCount = GetCurrentSynthesisCount();
-	for (const FMClassSynthesisSlot& SynthesisSlot : IngredientSlots)
-	{
-		for (int i = 0; i < SynthesisSlot.Ingredients.Num() && i < SynthesisCount; i++)
-		{
-			int Ingredient = SynthesisSlot.Ingredients[i];
-			Ingredients.FindOrAdd(Ingredient)++;
-		}
-	}
-
-	for (TPair<int, int> Pair : Ingredients)
-	{
-		if (Pair.Value <= 0)
-		{
-			continue;
-		}
-
-		std::shared_ptr<MItemT> Ingredient = std::make_shared<MItemT>();
-		Ingredient->itemTID = Pair.Key;
-		Ingredient->itemCount = Pair.Value;
-		Req.items.push_back(Ingredient);
-	}
-
-	MNETMGR->Send(Req);
-}
-
-void UMClassSynthesisUI::OnClickedCharacterListItem(int InTID)
-{
-	int Index = FindPossibleLeastCountSlotIndex();
-	if (Index >= 0)
-	{
-		PushIngredient(Index, InTID);
-	}
-}
-
-void UMClassSynthesisUI::OnClickedGrade(UObject* InObject)
-{
-	if (InObject == nullptr)
-	{
-		return;
-	}
-
-	if (const UMCategoryTabEntryData* EntryData = Cast<UMCategoryTabEntryData>(InObject))
-	{
-		if (const FMSynthesisData* Data = GetCurrentSynthesisData())
-		{
-			if (static_cast<int>(Data->Grade) != EntryData->Value)
-			{
-				ClearIngredient();
-			}
-		}
-
-		if (CharacterList)
-		{
-			CharacterList->SetCharacterGrade(EntryData->Value);
-		}
-
-		int Key = 0;
-		for (const TPair<int, const FMSynthesisData*> Pair : MDATAMGR->GetSynthesisMap())
-		{
-			if (Pair.Value->PawnType != PawnType)
-			{
-				continue;
-			}
-
-			if (Pair.Value->Grade == static_cast<EMGrade>(EntryData->Value))
-			{
-				Key = Pair.Key;
-				break;
-			}
-		}
-		SetSynthesisData(Key);
-
-	}
-
-	UpdateNoIngredientText();
-}
-
-void UMClassSynthesisUI::OnClickedSlot1()
-{
-	PopIngredient(0);
-}
-
-void UMClassSynthesisUI::OnClickedSlot2()
-{
-	PopIngredient(1);
-}
-
-void UMClassSynthesisUI::OnClickedSlot3()
-{
-	PopIngredient(2);
-}
-
-void UMClassSynthesisUI::OnClickedSlot4()
-{
-	PopIngredient(3);
-}
-
-void UMClassSynthesisUI::OnClickedPopupGachaAgainButton()
-{
-	AutoPushIngredient();
-	OnClickedSynthesisButton(EMCommonBtnType::None);
-}
-
-void UMClassSynthesisUI::CreateGradeTab()
-{
-	if (GradeListView)
-	{
-		EMMenuIconType MenuIconType = EMMenuIconType::Hero;
-		if (PawnType == EMPawnType::Pet)
-		{
-			MenuIconType = EMMenuIconType::Pet;
-		}
-
-		//	all.
-		if (const TObjectPtr<UMCategoryTabEntryData> AllEntryData = NewObject<UMCategoryTabEntryData>(this))
-		{
-			AllEntryData->Value = INDEX_NONE;
-			AllEntryData->Name = MStringHelper::FindLocTableText(EMLocTableType::UI, TEXT("Collection_Category_All"));
-			AllEntryData->MenuIconType = MenuIconType;
-
-			GradeListView->AddItem(AllEntryData);
-		}
-
-		//	grade.
-		for (int i = static_cast<int>(EMGrade::Legendary); i >= static_cast<int>(EMGrade::Common); i--)
-		{
-			if (TObjectPtr<UMCategoryTabEntryData> EntryData = NewObject<UMCategoryTabEntryData>(this))
-			{
-				EntryData->Value = i;
-				EntryData->Name = UMDataEnumString::GetGradeString(static_cast<EMGrade>(i));
-				EntryData->MenuIconType = MenuIconType;
-
-				GradeListView->AddItem(EntryData);
-			}
-		}
-	}
-
-	UpdateNoIngredientText();
-}
-
-void UMClassSynthesisUI::PushIngredient(const int InIndex, const int InTID)
-{
-	if (IngredientSlots.IsValidIndex(InIndex) == false)
-	{
-		return;
-	}
-
-	if (CanPushIngredient(InIndex, InTID) == false)
-	{
-		return;
-	}
-
-	if (GetCurrentSynthesisData() == nullptr)
-	{
-		if (const FMSynthesisData* SynthesisData = GetSynthesisDataFromPawn(InTID))
-		{
-			SetSynthesisData(SynthesisData->ID);
-		}
-	}
-
-	IngredientSlots[InIndex].Ingredients.Emplace(InTID);
-	CountMap.FindOrAdd(InTID)++;
-
-	UpdateCharacterCountOfTID(InTID);
-	UpdateSlot();
-	UpdateSynthesisCount();
-	UpdateSynthesisButton();
-	UpdateCanSynthesisImage();
-}
-
-bool UMClassSynthesisUI::AutoPushIngredient()
-{
-	int SynthesisCount = 0;
-	if (SynthesisTID <= 0)
-	{
-		for (const TPair<int, const FMSynthesisData*> Pair : MDATAMGR->GetSynthesisMap())
-		{
-			SynthesisCount = GetPossibleSynthesisCount(Pair.Key);
-			if (SynthesisCount > 0)
-			{
-				SetSynthesisData(Pair.Key);
-				break;
-			}
-		}
-	}
-	else
-	{
-		SynthesisCount = GetPossibleSynthesisCount(SynthesisTID);
-	}
-
-	if (SynthesisTID <= 0 || SynthesisCount <= 0)
-	{
-		return false;
-	}
-
-	const FMSynthesisData* SynthesisData = GetCurrentSynthesisData();
-	if (SynthesisData == nullptr)
-	{
-		return false;
-	}
-
-	TArray<int> Pawns;
-	if (CharacterList)
-	{
-		Pawns = CharacterList->GetItems();
-	}
-
-    for (int i = Pawns.Num() - 1; Pawns.IsValidIndex(i); i--)
-	{
-		int PawnTID = Pawns[i];
-		const FMPawnData* PawnData = MDATAMGR->GetPawnData(PawnTID);
-		if (PawnData == nullptr)
-		{
-			continue;
-		}
-
-		if (PawnData->Grade != SynthesisData->Grade)
-		{
-			continue;
-		}
-
-		while (true)
-		{
-			const int Index = FindPossibleLeastCountSlotIndex();
-			if (IngredientSlots.IsValidIndex(Index) == false)
-			{
-				break;
-			}
-
-			if (CanPushIngredient(Index, PawnTID) == false)
-			{
-				break;
-			}
-
-			PushIngredient(Index, PawnTID);
-		}
-
-		if (IngredientSlots.IsValidIndex(FindPossibleLeastCountSlotIndex()) == false)
-		{
-			break;
-		}
-	}
-
-	int Min = IngredientSlots[0].Ingredients.Num();
-	for (int i = 1; i < SynthesisData->MaterialCount; i++)
-	{
-		if (Min > IngredientSlots[i].Ingredients.Num())
-		{
-			Min = IngredientSlots[i].Ingredients.Num();
-		}
-	}
-
-	for (int i = 0 ; i < SynthesisData->MaterialCount; i++)
-	{
-		while (IngredientSlots[i].Ingredients.Num() > Min)
-		{
-			PopIngredient(i);
-		}
-	}
-
-	UpdateCharacterCountAll();
-	UpdateSlot();
-	UpdateSynthesisCount();
-	UpdateSynthesisButton();
-	UpdateCanSynthesisImage();
-
-	return true;
-}
-
-int UMClassSynthesisUI::PopIngredient(const int InIndex)
-{
-	if (IngredientSlots.IsValidIndex(InIndex) == false)
-	{
-		return 0;
-	}
-
-	if (IngredientSlots[InIndex].Ingredients.Num() <= 0)
-	{
-		return 0;
-	}
-
-	int Index = IngredientSlots[InIndex].Ingredients.Num() - 1;
-	int TID = IngredientSlots[InIndex].Ingredients[Index];
-	IngredientSlots[InIndex].Ingredients.RemoveAt(Index);
-	CountMap[TID]--;
-
-	UpdateCharacterCountOfTID(TID);
-	SettingSlotCount();
-	UpdateSlot();
-	UpdateSynthesisCount();
-	UpdateSynthesisButton();
-	UpdateCanSynthesisImage();
-
-	return TID;
-}
-
-void UMClassSynthesisUI::ClearIngredient()
-{
-	CountMap.Empty();
-
-	for (FMClassSynthesisSlot& SynthesisSlot : IngredientSlots)
-	{
-		SynthesisSlot.Ingredients.Reset();
-	}
-
-	UpdateCharacterCountAll();
-	SettingSlotCount();
-	UpdateSlot();
-	UpdateSynthesisCount();
-	UpdateSynthesisButton();
-	UpdateCanSynthesisImage();
-}
-
-bool UMClassSynthesisUI::CanPushIngredient(const int InIndex, const int InTID)
-{
-	if (IngredientSlots.IsValidIndex(InIndex) == false)
-	{
-		return false;
-	}
-
-	if (IsSlotFull(InIndex))
-	{
-		return false;
-	}
-
-	if (const FMSynthesisData* SynthesisData = GetCurrentSynthesisData())
-	{
-		const FMPawnData* PawnData = MDATAMGR->GetPawnData(InTID);
-		if (PawnData == nullptr)
-		{
-			return false;
-		}
-
-		if (PawnData->PawnType != SynthesisData->PawnType ||
-			PawnData->Grade != SynthesisData->Grade)
-		{
-			return false;
-		}
-
-		const int InsertedCount = CountMap.FindOrAdd(InTID);
-		return MNETDATAMGR->GetNetPawnHaveCount(InTID) - InsertedCount > 1;
-	}
-
-	if (GetSynthesisDataFromPawn(InTID))
-	{
-		return MNETDATAMGR->GetNetPawnHaveCount(InTID) > 1;
-	}
-
-	return false;
-}
-
-int UMClassSynthesisUI::GetPossibleSynthesisCount(const int InSynthesisTID) const
-{
-	const FMSynthesisData* SynthesisData = MDATAMGR->GetSynthesisData(InSynthesisTID);
-	if (SynthesisData == nullptr)
-	{
-		return 0;
-	}
-
-	if (PawnType != SynthesisData->PawnType)
-	{
-		return 0;
-	}
-
-	const EMGrade Grade = SynthesisData->Grade;
-
-	int Count = 0;
-	for (const int TID : MNETDATAMGR->GetHaveNetPawnArr(SynthesisData->PawnType))
-	{
-		const FMPawnData* PawnData = MDATAMGR->GetPawnData(TID);
-		if (PawnData == nullptr)
-		{
-			continue;
-		}
-		if (Grade != PawnData->Grade)
-		{
-			continue;
-		}
-
-		if (const int PawnCount = MNETDATAMGR->GetNetPawnHaveCount(TID); PawnCount > 1)
-		{
-			Count += PawnCount - 1;
-		}
-	}
-
-	return FMath::Min(Count / SynthesisData->MaterialCount, MAX_SYNTHESIS_COUNT);
-}
-
-bool UMClassSynthesisUI::IsSlotFull(const int InIndex) const
-{
-	if (IngredientSlots.IsValidIndex(InIndex) == false)
-	{
-		return false;
-	}
-
-	return IngredientSlots[InIndex].Ingredients.Num() >= MAX_SYNTHESIS_COUNT;
-}
-
-int UMClassSynthesisUI::GetIngredientCountOfTID(const int InTID) const
-{
-	if (CountMap.Find(InTID))
-	{
-		return CountMap[InTID];
-	}
-	return 0;
-}
-
-int UMClassSynthesisUI::GetIngredientCount(const int InIndex) const
-{
-	if (IngredientSlots.IsValidIndex(InIndex))
-	{
-		return IngredientSlots[InIndex].Ingredients.Num();
-	}
-	return -1;
-}
-
-int UMClassSynthesisUI::GetSlotCount() const
-{
-	if (const FMSynthesisData* SynthesisData = GetCurrentSynthesisData())
-	{
-		return SynthesisData->MaterialCount;
-	}
-
-	return 4;	// 아무런 재료 투입이 안되어있으면 4개 슬롯 표시
-}
-
-int UMClassSynthesisUI::FindPossibleLeastCountSlotIndex() const
-{
-	int Index = -1;
-	int MinCount = MAX_SYNTHESIS_COUNT;
-
-	for (int i = 0 ; i < GetSlotCount(); i++)
-	{
-		if (IngredientSlots[i].Ingredients.Num() < MinCount)
-		{
-			Index = IngredientSlots[i].Index;
-			MinCount = IngredientSlots[i].Ingredients.Num();
-		}
-	}
-
-	return Index;
-}
-
-int UMClassSynthesisUI::GetCurrentSynthesisCount() const
-{
-	int MinCount = MAX_SYNTHESIS_COUNT;
-	for (int i = 0 ; i < GetSlotCount(); i++)
-	{
-		if (IngredientSlots.IsValidIndex(i) == false)
-		{
-			continue;
-		}
-
-		if (IngredientSlots[i].Ingredients.Num() < MinCount)
-		{
-			MinCount = IngredientSlots[i].Ingredients.Num();
-		}
-	}
-
-	return MinCount;
-}
-
-void UMClassSynthesisUI::SettingSlotCount()
-{
-	int SlotCount = GetSlotCount();
-
-	for (int i = 0; i < SynthesisSlots.Num(); i++)
-	{
-		if (SynthesisSlots[i])
-		{
-			SynthesisSlots[i]->SetVisibility(i < SlotCount ? ESlateVisibility::Visible : ESlateVisibility::Collapsed);
-		}
-	}
-
-	UpdateSlot();
-}
-
-void UMClassSynthesisUI::UpdateSlot()
-{
-	for (int i = 0; i < GetSlotCount(); i++)
-	{
-		if (IngredientSlots.IsValidIndex(i) == false)
-		{
-			continue;
-		}
-
-		int Count = IngredientSlots[i].Ingredients.Num();
-		int Ingredient = Count > 0 ? IngredientSlots[i].Ingredients[0] : 0;
-
-		UMPawnIconUI* SynthesisSlot = SynthesisSlots[i];
-		if (SynthesisSlot)
-		{
-			if (Ingredient <= 0)
-			{
-				SynthesisSlot->EmptyIcon();
-			}
-			else
-			{
-				SynthesisSlot->SetItem(Ingredient, false, false, true, Count, false);
-			}
-		}
-	}
-}
-
-void UMClassSynthesisUI::UpdateCharacterCountAll()
-{
-	if (CharacterList)
-	{
-		for (const int TID : CharacterList->GetItems())
-		{
-			UpdateCharacterCountOfTID(TID);
-		}
-	}
-}
-
-void UMClassSynthesisUI::UpdateCharacterCountOfTID(const int InTID)
-{
-	if (CharacterList)
-	{
-		int Count = MNETDATAMGR->GetNetPawnHaveCount(InTID) - GetIngredientCountOfTID(InTID) - 1;
-		CharacterList->SetCharacterCount(InTID, Count);
-	}
-}
-
-void UMClassSynthesisUI::UpdateSynthesisCount()
-{
-	if (CountText)
-	{
-		int Count = GetCurrentSynthesisCount();
-		CountText->SetText(FText::AsNumber(Count));
-	}
-}
-
-void UMClassSynthesisUI::UpdateNoIngredientText()
-{
-	if (NoIngredientText)
-	{
-		NoIngredientText->SetVisibility(CharacterList->GetAddedItemCount() > 0 ? ESlateVisibility::Collapsed : ESlateVisibility::SelfHitTestInvisible);
-	}
-}
-
-void UMClassSynthesisUI::UpdateProbability()
-{
-	if (ProbabilityText)
-	{
-		const bool bIsActive = GetCurrentSynthesisData() != nullptr;
-
-		ProbabilityText->SetVisibility(bIsActive ? ESlateVisibility::SelfHitTestInvisible : ESlateVisibility::Collapsed);
-
-		if (bIsActive)
-		{
-			const float Probability = GetCurrentSynthesisData()->UpgradeProb / 100.0f;
-			FText Text = FText::Format(MStringHelper::FindLocTableText(EMLocTableType::UI, TEXT("Synthesis_UI_SynthesisProb")), Probability);
-			ProbabilityText->SetText(Text);
-		}
-	}
-}
-
-void UMClassSynthesisUI::UpdateSynthesisButton()
-{
-	if (SynthesisButtonCover)
-	{
-		SynthesisButtonCover->SetVisibility(CanSynthesis() ? ESlateVisibility::Collapsed : ESlateVisibility::HitTestInvisible);
-	}
-}
-
-void UMClassSynthesisUI::UpdateCanSynthesisImage()
-{
-	if (ImageCanSynthesis)
-	{
-		ImageCanSynthesis->SetVisibility(CanSynthesis() ? ESlateVisibility::HitTestInvisible : ESlateVisibility::Collapsed);
-	}
-
-	if (ImageCanNotSynthesis)
-	{
-		ImageCanNotSynthesis->SetVisibility(!CanSynthesis() ? ESlateVisibility::HitTestInvisible : ESlateVisibility::Collapsed);
-	}
-}
-
-bool UMClassSynthesisUI::CanSynthesis()
-{
-	return GetCurrentSynthesisCount() > 0;
-}
-
-const FMSynthesisData* UMClassSynthesisUI::GetSynthesisDataFromPawn(const int InTID) const
-{
-	if (const FMPawnData* PawnData = MDATAMGR->GetPawnData(InTID))
-	{
-		for (const TPair<int, const FMSynthesisData*> Pair : MDATAMGR->GetSynthesisMap())
-		{
-			if (Pair.Value->PawnType == PawnData->PawnType &&
-				Pair.Value->Grade == PawnData->Grade)
-			{
-				return Pair.Value;
-			}
-		}
-	}
-
-	return nullptr;
-}
-
-const FMSynthesisData* UMClassSynthesisUI::GetCurrentSynthesisData() const
-{
-	if (SynthesisTID > 0)
-	{
-		return MDATAMGR->GetSynthesisData(SynthesisTID);
-	}
-	return nullptr;
-}
-
-void UMClassSynthesisUI::SetSynthesisData(const int InTID)
-{
-	if (const FMSynthesisData* Data = MDATAMGR->GetSynthesisData(InTID))
-	{
-		SynthesisTID = InTID;
-
-		int i;
-		// 합성 데이터가 정해지면 해당 등급 탭으로 강제이동
-		for (i = 1; i < GradeListView->GetNumItems(); i++)
-		{
-			if (UMCategoryTabEntryData* Entry = Cast<UMCategoryTabEntryData>(GradeListView->GetItemAt(i)))
-			{
-				EMGrade Grade = static_cast<EMGrade>(Entry->Value);
-				if (Grade == Data->Grade &&
-					GradeListView->GetSelectedItem<UMCategoryTabEntryData>() != Entry)
-				{
-					break;
-				}
-			}
-		}
-
-		if (i < GradeListView->GetNumItems())
-		{
-			GradeListView->SetSelectedIndex(i);
-		}
-	}
-	else
-	{
-		SynthesisTID = 0;
-	}
-
-	SettingSlotCount();
-	UpdateProbability();
-	UpdateSynthesisButton();
-}
-
-void UMClassSynthesisUI::RecvCombineAck(FCombineAckT* InPacket)
-{
-	if (InPacket == nullptr)
-	{
-		return;
-	}
-
-	if (InPacket->result != EResultID::R_SUCCESS)
-	{
-		return;
-	}
-
-	int PrevTID = SynthesisTID;
-
-	ClearIngredient();
-
-	EMRewardItemType RewardType = EMRewardItemType::None;
-	TMap<int32, int> RewardMap;
-
-	for (std::shared_ptr<MRewardItemT> Reward : InPacket->rewards)
-	{
-		if (Reward == nullptr)
-		{
-			continue;
-		}
-
-		int& Count = RewardMap.FindOrAdd(Reward->itemtid);
-		Count += Reward->value;
-	}
-
-	if (PawnType == EMPawnType::Hero)
-	{
-		RewardType = EMRewardItemType::Hero;
-	}
-	else if (PawnType == EMPawnType::Pet)
-	{
-		RewardType = EMRewardItemType::Pet;
-	}
-
-	if (RewardType != EMRewardItemType::None)
-	{
-		MUIMGR->GachaUIOpen(EMGachaType::Synthesis, RewardType, RewardMap, 0);
-		if (UMGachaUI* UI = Cast<UMGachaUI>(MUIMGR->GetOpenUI(TEXT("GachaUI"))))
-		{
-			UI->SetTryAgainCount(GetPossibleSynthesisCount(PrevTID));
-		}
-	}
-
-	if (UMClassTabUI* Menubar = Slot->GetTypedOuter<UMClassTabUI>())
-	{
-		Menubar->UpdateRedDot();
-	}
-}
+/***********************************************************************************
+ *                                                                                 *
+ * Copyright. (C) 2023 Mobirix.                                                    *
+ * Website: https://mobirix.com													   *
+ *                                                                                 *
+ ***********************************************************************************/
+
+#include "UI/Class/MClassSynthesisUI.h"
+
+#include "Components/Button.h"
+#include "Components/Image.h"
+#include "Components/ListView.h"
+#include "Components/TextBlock.h"
+#include "Core/MMemoryTracker.h"
+#include "Data/MDataManager.h"
+#include "Data/Base/MDataEnumString.h"
+#include "Data/Base/MdataStruct.h"
+#include "Engine/World.h"
+#include "HAL/IConsoleManager.h"
+#include "TimerManager.h"
+#include "Util/MGlobalFunctionLib.h"
+#include "Network/MNetworkManager.h"
+#include "Network/Data/MNetworkDataManager.h"
+#include "Synthesis/MCombineLatency.h"
+#include "Synthesis/MCombineLoopbackServer.h"
+#include "Synthesis/MPawnInventorySnapshot.h"
+#include "Synthesis/MRewardAssetPrefetcher.h"
+#include "Synthesis/MSynthesisRedDot.h"
+#include "Synthesis/MSynthesisPlanner.h"
+#include "Synthesis/MSynthesisSimulator.h"
+#include "UI/MUIManager.h"
+#include "UI/Class/MClassTabUI.h"
+#include "UI/Common/MCharacterListUI.h"
+#include "UI/Common/MCommonBtn.h"
+#include "UI/Common/Icon/MPawnIconUI.h"
+#include "UI/Common/PressButton/MCategoryTabEntryUI.h"
+#include "UI/Gacha/MGachaUI.h"
+#include "Util/MStringHelper.h"
+
+#define MAX_SYNTHESIS_COUNT 11
+#define SYNTHESIS_PREVIEW_CHAIN_COUNT 20000
+
+namespace MClassSynthesis
+{
+	float RewardAssetWaitSeconds = 0.5f;
+	FAutoConsoleVariableRef CVarRewardAssetWaitSeconds(TEXT("MSynthesis.RewardAssetWaitSeconds"), RewardAssetWaitSeconds, TEXT("Longest time the synthesis reward reveal waits for reward assets to stream in. 0 opens it immediately."));
+}
+
+void UMClassSynthesisUI::NativeOnInitialized()
+{
+	Super::NativeOnInitialized();
+
+	if (GradeListView)
+	{
+		GradeListView->OnItemSelectionChanged().AddUObject(this, &UMClassSynthesisUI::OnClickedGrade);
+		GradeListView->SetScrollbarVisibility(ESlateVisibility::Collapsed);
+	}
+
+	if (ButtonAuto)
+	{
+		ButtonAuto->SetCommonBtn(EMCommonBtnType::Normal, MStringHelper::FindLocTableText(EMLocTableType::UI, TEXT("Common_UI_Automatic")));
+	}
+
+	if (ButtonSynthesis)
+	{
+		ButtonSynthesis->SetCommonBtn(EMCommonBtnType::Normal, MStringHelper::FindLocTableText(EMLocTableType::UI, TEXT("Synthesis_UI_Synthesis")));
+	}
+
+	if (ButtonRepeatSynthesis)
+	{
+		ButtonRepeatSynthesis->SetCommonBtn(EMCommonBtnType::Normal, MStringHelper::FindLocTableText(EMLocTableType::UI, TEXT("Synthesis_UI_RepeatSynthesis")));
+	}
+
+	if (ButtonSynthesisAll)
+	{
+		ButtonSynthesisAll->SetCommonBtn(EMCommonBtnType::Normal, MStringHelper::FindLocTableText(EMLocTableType::UI, TEXT("Synthesis_UI_SynthesisAll")));
+	}
+
+	SynthesisSlots.Emplace(SynthesisSlot1);
+	SynthesisSlots.Emplace(SynthesisSlot2);
+	SynthesisSlots.Emplace(SynthesisSlot3);
+	SynthesisSlots.Emplace(SynthesisSlot4);
+
+	SlotButtons.Emplace(ButtonSlot1);
+	SlotButtons.Emplace(ButtonSlot2);
+	SlotButtons.Emplace(ButtonSlot3);
+	SlotButtons.Emplace(ButtonSlot4);
+
+	ButtonSlot1->OnClicked.AddDynamic(this, &UMClassSynthesisUI::OnClickedSlot1);
+	ButtonSlot2->OnClicked.AddDynamic(this, &UMClassSynthesisUI::OnClickedSlot2);
+	ButtonSlot3->OnClicked.AddDynamic(this, &UMClassSynthesisUI::OnClickedSlot3);
+	ButtonSlot4->OnClicked.AddDynamic(this, &UMClassSynthesisUI::OnClickedSlot4);
+
+	OnVisibilityChanged.AddDynamic(this, &UMClassSynthesisUI::OnSynthesisVisibilityChanged);
+
+	CharacterListFilter.SetFilter([ this ] (const int InTID)
+	{
+		return this->GetHaveCount(InTID) > 1;
+	}, EMListFilterDependency::Inventory);
+
+	CharacterDimmedFilter.SetFilter([ this ] (const int InTID)
+	{
+		return (this->GetHaveCount(InTID) - this->GetIngredientCountOfTID(InTID)) <= 1;
+	}, EMListFilterDependency::Inventory | EMListFilterDependency::Ingredient);
+
+	DataProvider.Build();
+	SynthesisModel.Initialize(&InventoryProvider, &DataProvider, SynthesisSlots.Num(), MAX_SYNTHESIS_COUNT);
+
+	RegisterMemoryReporters();
+}
+
+void UMClassSynthesisUI::NativeConstruct()
+{
+	Super::NativeConstruct();
+
+	if (const UMBaseUIWidget* Menubar = Slot->GetTypedOuter<UMClassTabUI>())
+	{
+		if (const FMUILoadData* LoadData = Menubar->GetUILoadInfo())
+		{
+			if (LoadData->ID == "ClassUI")
+			{
+				PawnType = EMPawnType::Hero;
+			}
+			else if (LoadData->ID == "PetUI")
+			{
+				PawnType = EMPawnType::Pet;
+			}
+			else if (LoadData->ID == "VehicleUI")
+			{
+				PawnType = EMPawnType::Vehicle;
+			}
+		}
+	}
+
+	if (ButtonAuto)
+	{
+		ButtonAuto->DelegateCommonBtnClickedEvent.BindUObject(this, &UMClassSynthesisUI::OnClickedAutoButton);
+	}
+
+	if (ButtonClear)
+	{
+		ButtonClear->DelegateCommonBtnClickedEvent.BindUObject(this, &UMClassSynthesisUI::OnClockedClearButton);
+	}
+
+	if (ButtonSynthesis)
+	{
+		ButtonSynthesis->DelegateCommonBtnClickedEvent.BindUObject(this, &UMClassSynthesisUI::OnClickedSynthesisButton);
+	}
+
+	if (ButtonRepeatSynthesis)
+	{
+		ButtonRepeatSynthesis->DelegateCommonBtnClickedEvent.BindUObject(this, &UMClassSynthesisUI::OnClickedRepeatSynthesisButton);
+	}
+
+	if (ButtonSynthesisAll)
+	{
+		ButtonSynthesisAll->DelegateCommonBtnClickedEvent.BindUObject(this, &UMClassSynthesisUI::OnClickedSynthesisAllButton);
+	}
+
+	MNETMGR->OnRecvCombineAck.AddUObject(this, &UMClassSynthesisUI::RecvCombineAck);
+
+	if (CharacterList)
+	{
+		CharacterList->HideRedDot(true);
+		CharacterList->HideSelection(true);
+		CharacterList->HideEquipMark(true);
+
+		EMCharacterListUIType Type = EMCharacterListUIType::Class;
+		if (PawnType == EMPawnType::Pet)
+		{
+			Type = EMCharacterListUIType::Pet;
+		}
+		else if (PawnType == EMPawnType::Vehicle)
+		{
+			Type = EMCharacterListUIType::Vehicle;
+		}
+
+		CharacterList->SetCharacterListUIType(Type);
+
+		CharacterList->OnClickedCharacterListItem.BindUObject(this, &UMClassSynthesisUI::OnClickedCharacterListItem);
+
+		CharacterList->SetListFilter([ this ] (const int InTID)
+		{
+			return this->CharacterListFilter.Evaluate(InTID);
+		});
+
+		CharacterList->SetDimmedFilter([ this ] (const int InTID)
+		{
+			return this->CharacterDimmedFilter.Evaluate(InTID);
+		});
+
+		CharacterList->SetVisibleCharacterCount(true);
+
+		CharacterList->HideExploringMark(true);
+	}
+
+	SynthesisModel.SetRecipe(SynthesisTID);
+
+	MUIMGR->DelegateGachaAgainSynthesis.Unbind();
+	MUIMGR->DelegateGachaAgainSynthesis.BindUObject(this, &UMClassSynthesisUI::OnClickedPopupGachaAgainButton);
+
+	RefreshSynthesisView();
+}
+
+void UMClassSynthesisUI::NativeDestruct()
+{
+	if (ButtonAuto)
+	{
+		ButtonAuto->DelegateCommonBtnClickedEvent.Unbind();
+	}
+
+	if (ButtonClear)
+	{
+		ButtonClear->DelegateCommonBtnClickedEvent.Unbind();
+	}
+
+	if (ButtonSynthesis)
+	{
+		ButtonSynthesis->DelegateCommonBtnClickedEvent.Unbind();
+	}
+
+	if (ButtonRepeatSynthesis)
+	{
+		ButtonRepeatSynthesis->DelegateCommonBtnClickedEvent.Unbind();
+	}
+
+	if (ButtonSynthesisAll)
+	{
+		ButtonSynthesisAll->DelegateCommonBtnClickedEvent.Unbind();
+	}
+
+	if (CharacterList)
+	{
+		CharacterList->OnClickedCharacterListItem.Unbind();
+		CharacterList->RemoveDimmedFilter();
+		CharacterList->RemoveListFilter();
+	}
+
+	MNETMGR->OnRecvCombineAck.RemoveAll(this);
+
+	PlannedCombines.Reset();
+	InFlightCombines.Reset();
+	PendingPlanSteps.Reset();
+	PendingPlanVersion = 0;
+	RepeatRewardMap.Reset();
+	PredictedConsumeMap.Reset();
+	InventorySnapshot.Reset();
+	PossibleCountCache.Reset();
+	PossibleCountByGrade.Reset();
+	PossibleCountCacheVersion = 0;
+	DirtyCountTIDs.Reset();
+	CharacterListFilter.Reset();
+	CharacterDimmedFilter.Reset();
+	GradeListIndex.Reset();
+	SelectedGrade = INDEX_NONE;
+	SynthesisPlanRequest = 0;
+	SynthesisPreviewRequest = 0;
+	if (UWorld* World = GetWorld())
+	{
+		World->GetTimerManager().ClearTimer(RewardAssetWaitTimer);
+	}
+	bRewardRevealPending = false;
+	PendingRewardMap.Reset();
+	RewardAssetHandle.Reset();
+	RewardPoolAssetHandle.Reset();
+	RewardPoolAssetGrade = 0;
+	PendingRewardAssetHandles.Reset();
+	RepeatSynthesisTID = 0;
+	bSynthesisViewDirty = false;
+
+	MUIMGR->DelegateGachaAgainSynthesis.Unbind();
+
+	Super::NativeDestruct();
+}
+
+void UMClassSynthesisUI::BeginDestroy()
+{
+	for (const FDelegateHandle& Handle : MemoryReporterHandles)
+	{
+		FMMemoryTracker::Get().RemoveReporter(Handle);
+	}
+	MemoryReporterHandles.Reset();
+
+	Super::BeginDestroy();
+}
+
+void UMClassSynthesisUI::RegisterMemoryReporters()
+{
+	// 닫힌 뒤에도 위젯이 재사용되는 동안은 테이블과 풀을 들고 있으므로 소멸할 때까지 보고한다.
+	MemoryReporterHandles.Emplace(FMMemoryTracker::Get().AddReporter(EMMemoryTag::SynthesisModel, FMOnReportMemory::CreateWeakLambda(this, [ this ] (FMMemoryReport& OutReport)
+	{
+		OutReport.Add(1, SynthesisModel.GetAllocatedSize() + PlannedCombines.GetAllocatedSize() + InFlightCombines.GetAllocatedSize() + RepeatRewardMap.GetAllocatedSize() + PredictedConsumeMap.GetAllocatedSize());
+	})));
+
+	MemoryReporterHandles.Emplace(FMMemoryTracker::Get().AddReporter(EMMemoryTag::SynthesisCache, FMOnReportMemory::CreateWeakLambda(this, [ this ] (FMMemoryReport& OutReport)
+	{
+		SIZE_T Bytes = DataProvider.GetAllocatedSize();
+		Bytes += CharacterListFilter.GetAllocatedSize() + CharacterDimmedFilter.GetAllocatedSize();
+		Bytes += GradeListIndex.GetAllocatedSize();
+		Bytes += PossibleCountCache.GetAllocatedSize() + PossibleCountByGrade.GetAllocatedSize() + DirtyCountTIDs.GetAllocatedSize();
+
+		if (InventorySnapshot.IsValid())
+		{
+			Bytes += sizeof(FMPawnInventorySnapshot) + InventorySnapshot->GetAllocatedSize();
+		}
+
+		OutReport.Add(1, Bytes);
+	})));
+
+	MemoryReporterHandles.Emplace(FMMemoryTracker::Get().AddReporter(EMMemoryTag::SynthesisUIPool, FMOnReportMemory::CreateWeakLambda(this, [ this ] (FMMemoryReport& OutReport)
+	{
+		SIZE_T Bytes = GradeEntryDatas.GetAllocatedSize();
+		for (const TObjectPtr<UMCategoryTabEntryData>& EntryData : GradeEntryDatas)
+		{
+			if (EntryData)
+			{
+				Bytes += EntryData->GetClass()->GetStructureSize();
+			}
+		}
+
+		OutReport.Add(GradeEntryDatas.Num(), Bytes);
+	})));
+}
+
+void UMClassSynthesisUI::ReOpenUI(ESlateVisibility InVisibility)
+{
+	Super::ReOpenUI(InVisibility);
+
+	if (bSynthesisViewDirty)
+	{
+		RefreshSynthesisView();
+		return;
+	}
+
+	RefreshInventorySnapshot();
+
+	if (GradeListView)
+	{
+		GradeListView->SetSelectedIndex(0);
+	}
+
+	ClearIngredient();
+}
+
+void UMClassSynthesisUI::OnClickedAutoButton(EMCommonBtnType ButtonType)
+{
+	if (IsRepeatSynthesis())
+	{
+		return;
+	}
+
+	if (AutoPushIngredient() == false)
+	{
+		MUIMGR->SetGameToastMessage("347");
+		return;
+	}
+	
+	UpdateNoIngredientText();
+}
+
+void UMClassSynthesisUI::OnClockedClearButton(EMCommonBtnType ButtonType)
+{
+	if (IsRepeatSynthesis())
+	{
+		return;
+	}
+
+	ClearIngredient();
+	UpdateNoIngredientText();
+}
+
+void UMClassSynthesisUI::OnClickedSynthesisButton(EMCommonBtnType ButtonType)
+{
+	if (IsRepeatSynthesis() || InFlightCombines.Num() > 0)
+	{
+		return;
+	}
+
+	if (CanSynthesis() == false)
+	{
+		MUIMGR->SetGameToastMessage("348");
+		return;
+	}
+
+	LastRepeatCount = 0;
+
+	FMSynthesisCombineBatch Batch;
+	Batch.SynthesisCount = SynthesisModel.BuildIngredients(Batch.Ingredients);
+
+	SendCombineBatch(MoveTemp(Batch));
+
+	// 투입된 재료는 예측 소모량으로 넘어갔으므로 응답을 기다리지 않고 슬롯을 비운다.
+	ClearIngredient();
+	UpdateNoIngredientText();
+}
+
+void UMClassSynthesisUI::OnClickedRepeatSynthesisButton(EMCommonBtnType ButtonType)
+{
+	if (IsRepeatSynthesis() || InFlightCombines.Num() > 0)
+	{
+		return;
+	}
+
+	if (StartRepeatSynthesis(RepeatSynthesisCount) == false)
+	{
+		MUIMGR->SetGameToastMessage("347");
+	}
+}
+
+void UMClassSynthesisUI::OnClickedSynthesisAllButton(EMCommonBtnType ButtonType)
+{
+	if (IsRepeatSynthesis() || InFlightCombines.Num() > 0 || SynthesisPlanRequest > 0)
+	{
+		return;
+	}
+
+	RequestSynthesisPlan();
+}
+
+void UMClassSynthesisUI::RequestSynthesisPlan()
+{
+	if (InventorySnapshot.IsValid() == false)
+	{
+		return;
+	}
+
+	RefreshSynthesisDataIfStale();
+
+	TArray<FMSynthesisRecipe> Recipes;
+	for (const FMSynthesisRecipe& Recipe : DataProvider.GetRecipes().GetRecords())
+	{
+		if (Recipe.PawnType == static_cast<int>(PawnType))
+		{
+			Recipes.Emplace(Recipe);
+		}
+	}
+
+	const int Request = ++NextSynthesisPlanRequest;
+	SynthesisPlanRequest = Request;
+
+	TWeakObjectPtr<UMClassSynthesisUI> WeakThis(this);
+	FMSynthesisPlanner::PlanAsync(InventorySnapshot.ToSharedRef(), MoveTemp(Recipes), MAX_SYNTHESIS_COUNT, [ WeakThis, Request ] (FMSynthesisPlan&& InPlan)
+	{
+		if (UMClassSynthesisUI* This = WeakThis.Get())
+		{
+			if (This->SynthesisPlanRequest == Request)
+			{
+				This->OnSynthesisPlanCompleted(MoveTemp(InPlan));
+			}
+		}
+	});
+}
+
+void UMClassSynthesisUI::OnSynthesisPlanCompleted(FMSynthesisPlan&& InPlan)
+{
+	SynthesisPlanRequest = 0;
+
+	// 계획을 세우는 동안 다른 합성이 시작됐으면 버린다.
+	if (IsRepeatSynthesis() || InFlightCombines.Num() > 0)
+	{
+		return;
+	}
+
+	UpdatePlanResultText(InPlan);
+
+	// 낮은 등급부터 한 단계씩 반복 합성으로 진행하고, 단계가 끝나면 FinishRepeatSynthesis에서 다음 단계로 넘어간다.
+	PendingPlanSteps = MoveTemp(InPlan.Steps);
+	PendingPlanVersion = InPlan.InventoryVersion;
+	RepeatRewardMap.Reset();
+	LastRepeatCount = 0;
+
+	if (StartNextPlanStep() == false)
+	{
+		MUIMGR->SetGameToastMessage("347");
+	}
+}
+
+bool UMClassSynthesisUI::StartNextPlanStep()
+{
+	while (PendingPlanSteps.Num() > 0)
+	{
+		FMSynthesisPlanStep Step = MoveTemp(PendingPlanSteps[0]);
+		PendingPlanSteps.RemoveAt(0);
+
+		const FMSynthesisRecipe* Recipe = DataProvider.GetRecipes().Find(Step.SynthesisTID);
+		if (Recipe == nullptr || Recipe->MaterialCount <= 0)
+		{
+			continue;
+		}
+
+		SetSynthesisData(Step.SynthesisTID);
+
+		PlannedCombines.Reset();
+		if (InventorySnapshot.IsValid() && InventorySnapshot->GetVersion() == PendingPlanVersion && Step.Ingredients.Num() > 0)
+		{
+			// 계획을 세운 스냅샷 그대로면 계획이 고른 재료를 쓴다.
+			SplitCombineBatches(Step.Ingredients, Recipe->MaterialCount, Step.RequestCount, PlannedCombines);
+		}
+		else
+		{
+			// 하위 등급 합성으로 보유 수량이 바뀌었으므로 지금 스냅샷에서 남는 재료를 모두 쓴다.
+			PlanCombineBatches(MAX_int32, PlannedCombines);
+		}
+
+		if (PlannedCombines.Num() > 0)
+		{
+			BeginRepeatSynthesis();
+			return true;
+		}
+	}
+
+	return false;
+}
+
+void UMClassSynthesisUI::UpdatePlanResultText(const FMSynthesisPlan& InPlan)
+{
+	if (PlanResultText == nullptr)
+	{
+		return;
+	}
+
+	FNumberFormattingOptions Options;
+	Options.MinimumFractionalDigits = 1;
+	Options.MaximumFractionalDigits = 1;
+
+	// 등급별 획득 기대값. 0등급은 합성 결과로 얻을 수 없으므로 건너뛴다.
+	TArray<FText> GainTexts;
+	for (int Grade = 1; Grade < InPlan.ExpectedGainByGrade.Num(); Grade++)
+	{
+		const double Gain = InPlan.ExpectedGainByGrade[Grade];
+		if (Gain > 0.0)
+		{
+			GainTexts.Emplace(FText::Format(MStringHelper::FindLocTableText(EMLocTableType::UI, TEXT("Synthesis_UI_PlanGradeGain")), UMDataEnumString::GetGradeString(static_cast<EMGrade>(Grade)), FText::AsNumber(Gain, &Options)));
+		}
+	}
+
+	PlanResultText->SetText(FText::Format(MStringHelper::FindLocTableText(EMLocTableType::UI, TEXT("Synthesis_UI_PlanResult")), FText::AsNumber(InPlan.TotalRounds), FText::AsNumber(InPlan.ExpectedTopGradeCount, &Options), FText::Join(FText::FromString(TEXT("\n")), GainTexts)));
+	PlanResultText->SetVisibility(ESlateVisibility::HitTestInvisible);
+}
+
+void UMClassSynthesisUI::SendCombineBatch(FMSynthesisCombineBatch&& InBatch)
+{
+	FCombineReqT* Req = nullptr;
+	{
+		MCOMBINE_LATENCY_SCOPE(BuildRequest);
+		Req = &CombineReqBuilder.Build(InBatch.Ingredients);
+	}
+
+	{
+		MCOMBINE_LATENCY_SCOPE(Send);
+		if (FMCombineLoopbackServer::IsEnabled())
+		{
+			FMCombineLoopbackServer::Send(*Req);
+		}
+		else
+		{
+			MNETMGR->Send(*Req);
+		}
+	}
+
+	InBatch.SendTime = FPlatformTime::Seconds();
+
+	if (const FMSynthesisData* SynthesisData = GetCurrentSynthesisData())
+	{
+		const int RewardGrade = static_cast<int>(SynthesisData->Grade) + 1;
+		if (RewardPoolAssetGrade != RewardGrade)
+		{
+			RewardPoolAssetGrade = RewardGrade;
+			RewardPoolAssetHandle = FMRewardAssetPrefetcher::PrefetchRewardPool(PawnType, static_cast<EMGrade>(RewardGrade));
+		}
+	}
+
+	ApplyPredictedConsume(InBatch, 1);
+	InFlightCombines.Emplace(MoveTemp(InBatch));
+}
+
+void UMClassSynthesisUI::ApplyPredictedConsume(const FMSynthesisCombineBatch& InBatch, const int InSign, const TArray<int>& InRewardTIDs)
+{
+	TArray<int> DirtyTIDs;
+	DirtyTIDs.Reserve(InBatch.Ingredients.Num() + InRewardTIDs.Num());
+
+	for (const TPair<int, int>& Pair : InBatch.Ingredients)
+	{
+		int& Count = PredictedConsumeMap.FindOrAdd(Pair.Key);
+		Count += Pair.Value * InSign;
+		if (Count <= 0)
+		{
+			PredictedConsumeMap.Remove(Pair.Key);
+		}
+
+		DirtyTIDs.Emplace(Pair.Key);
+	}
+
+	DirtyTIDs.Append(InRewardTIDs);
+
+	RefreshInventorySnapshot(&DirtyTIDs);
+}
+
+void UMClassSynthesisUI::RefreshSynthesisDataIfStale()
+{
+	if (DataProvider.IsStale() == false)
+	{
+		return;
+	}
+
+	// 게임 스레드에서 전체를 다시 만들지 않고 다시 읽힌 테이블만 옮긴다.
+	if (DataProvider.Refresh())
+	{
+		SynthesisModel.SetRecipe(SynthesisTID);
+	}
+
+	PossibleCountCacheVersion = 0;
+	CharacterListFilter.Reset();
+	CharacterDimmedFilter.Reset();
+	GradeListIndex.Reset();
+}
+
+void UMClassSynthesisUI::RefreshInventorySnapshot(const TArray<int>* InDirtyTIDs)
+{
+	// 합성 데이터가 바뀌면 재료 수도 바뀔 수 있으므로 레드닷을 다시 만든다.
+	const bool bDataStale = DataProvider.IsStale();
+	RefreshSynthesisDataIfStale();
+
+	// 합성 요청과 응답마다 불리므로 바뀐 TID만 덮어쓰고 정렬은 다시 하지 않는다.
+	const TSharedPtr<const FMPawnInventorySnapshot> Previous = InventorySnapshot;
+	if (InDirtyTIDs && Previous.IsValid() && bDataStale == false)
+	{
+		InventorySnapshot = FMPawnInventorySnapshot::Update(Previous.ToSharedRef(), *InDirtyTIDs, PredictedConsumeMap, &DataProvider);
+	}
+	else
+	{
+		InventorySnapshot = FMPawnInventorySnapshot::Build(PawnType, PredictedConsumeMap, Previous, &DataProvider);
+	}
+	InventoryProvider.SetSnapshot(InventorySnapshot);
+
+	// 레드닷 추적기는 응답을 기다리는 예측 소모량을 빼지 않은 서버 보유 수량으로 갱신한다.
+	FMSynthesisRedDotTracker& RedDot = FMSynthesisRedDotTracker::Get();
+	if (Previous.IsValid() == false || bDataStale || RedDot.IsBuilt(static_cast<int>(PawnType)) == false)
+	{
+		TArray<int> ConfirmedCounts;
+		ConfirmedCounts.Reserve(InventorySnapshot->Num());
+		for (const int TID : InventorySnapshot->GetTIDs())
+		{
+			ConfirmedCounts.Emplace(MNETDATAMGR->GetNetPawnHaveCount(TID));
+		}
+
+		RedDot.Rebuild(static_cast<int>(PawnType), InventorySnapshot->GetTIDs(), ConfirmedCounts, DataProvider);
+	}
+
+	if (Previous.IsValid() == false)
+	{
+		CharacterListFilter.Reset();
+		CharacterDimmedFilter.Reset();
+	}
+	else if (Previous != InventorySnapshot)
+	{
+		TArray<int> ChangedTIDs;
+		InventorySnapshot->GetChangedTIDs(*Previous, ChangedTIDs);
+
+		CharacterListFilter.Invalidate(EMListFilterDependency::Inventory, ChangedTIDs);
+		CharacterDimmedFilter.Invalidate(EMListFilterDependency::Inventory, ChangedTIDs);
+		UpdateGradeTabCounts();
+
+		for (const int TID : ChangedTIDs)
+		{
+			DirtyCountTIDs.Emplace(TID);
+
+			if (bDataStale == false)
+			{
+				RedDot.OnPawnCountChanged(TID, MNETDATAMGR->GetNetPawnHaveCount(TID), DataProvider);
+			}
+		}
+
+		FlushCharacterCount();
+	}
+
+	// 응답으로 예측 소모량과 서버 수량이 함께 줄면 스냅샷은 그대로라 위에서 빠진다.
+	if (InDirtyTIDs && Previous.IsValid() && bDataStale == false)
+	{
+		for (const int TID : *InDirtyTIDs)
+		{
+			RedDot.OnPawnCountChanged(TID, MNETDATAMGR->GetNetPawnHaveCount(TID), DataProvider);
+		}
+	}
+}
+
+int UMClassSynthesisUI::GetHaveCount(const int InTID) const
+{
+	return InventorySnapshot.IsValid() ? InventorySnapshot->GetCount(InTID) : 0;
+}
+
+void UMClassSynthesisUI::OnClickedCharacterListItem(int InTID)
+{
+	if (IsRepeatSynthesis())
+	{
+		return;
+	}
+
+	int Index = FindPossibleLeastCountSlotIndex();
+	if (Index >= 0)
+	{
+		PushIngredient(Index, InTID);
+	}
+}
+
+void UMClassSynthesisUI::OnClickedGrade(UObject* InObject)
+{
+	if (InObject == nullptr)
+	{
+		return;
+	}
+
+	if (const UMCategoryTabEntryData* EntryData = Cast<UMCategoryTabEntryData>(InObject))
+	{
+		if (const FMSynthesisData* Data = GetCurrentSynthesisData())
+		{
+			if (static_cast<int>(Data->Grade) != EntryData->Value)
+			{
+				ClearIngredient();
+			}
+		}
+
+		SelectedGrade = EntryData->Value;
+
+		if (CharacterList)
+		{
+			CharacterList->SetCharacterGrade(EntryData->Value);
+		}
+
+		FMSynthesisPawnInfo PawnInfo;
+		PawnInfo.PawnType = static_cast<int>(PawnType);
+		PawnInfo.Grade = EntryData->Value;
+
+		const FMSynthesisRecipe* Recipe = DataProvider.FindRecipeOfPawn(PawnInfo);
+		SetSynthesisData(Recipe ? Recipe->SynthesisTID : 0);
+
+	}
+
+	UpdateNoIngredientText();
+}
+
+void UMClassSynthesisUI::OnClickedSlot1()
+{
+	if (IsRepeatSynthesis())
+	{
+		return;
+	}
+
+	PopIngredient(0);
+}
+
+void UMClassSynthesisUI::OnClickedSlot2()
+{
+	if (IsRepeatSynthesis())
+	{
+		return;
+	}
+
+	PopIngredient(1);
+}
+
+void UMClassSynthesisUI::OnClickedSlot3()
+{
+	if (IsRepeatSynthesis())
+	{
+		return;
+	}
+
+	PopIngredient(2);
+}
+
+void UMClassSynthesisUI::OnClickedSlot4()
+{
+	if (IsRepeatSynthesis())
+	{
+		return;
+	}
+
+	PopIngredient(3);
+}
+
+void UMClassSynthesisUI::OnClickedPopupGachaAgainButton()
+{
+	if (LastRepeatCount > 0)
+	{
+		StartRepeatSynthesis(LastRepeatCount);
+		return;
+	}
+
+	AutoPushIngredient();
+	OnClickedSynthesisButton(EMCommonBtnType::None);
+}
+
+void UMClassSynthesisUI::OnSynthesisVisibilityChanged(ESlateVisibility InVisibility)
+{
+	if (bSynthesisViewDirty && IsVisible())
+	{
+		RefreshSynthesisView();
+	}
+}
+
+void UMClassSynthesisUI::RefreshSynthesisView()
+{
+	// 탭 전환으로 숨겨진 채 생성되는 경우가 많아 실제로 보일 때까지 갱신을 미룬다.
+	if (IsVisible() == false)
+	{
+		bSynthesisViewDirty = true;
+		return;
+	}
+
+	bSynthesisViewDirty = false;
+
+	RefreshInventorySnapshot();
+	CreateGradeTab();
+	ClearIngredient();
+	SettingSlotCount();
+	UpdateSlot();
+	UpdateCharacterCountAll();
+	UpdateSynthesisCount();
+	UpdateNoIngredientText();
+	UpdateSynthesisButton();
+	UpdateProbability();
+	UpdateCanSynthesisImage();
+
+	if (GradeListView)
+	{
+		GradeListView->SetSelectedIndex(0);
+	}
+}
+
+void UMClassSynthesisUI::CreateGradeTab()
+{
+	if (GradeListView)
+	{
+		EMMenuIconType MenuIconType = EMMenuIconType::Hero;
+		if (PawnType == EMPawnType::Pet)
+		{
+			MenuIconType = EMMenuIconType::Pet;
+		}
+
+		if (GradeEntryDatas.Num() > 0 && GradeEntryDatas[0] && GradeEntryDatas[0]->MenuIconType == MenuIconType)
+		{
+			if (GradeListView->GetNumItems() != GradeEntryDatas.Num())
+			{
+				GradeListView->SetListItems(GradeEntryDatas);
+			}
+
+			UpdateGradeTabCounts();
+			UpdateNoIngredientText();
+			return;
+		}
+
+		GradeEntryDatas.Reset();
+
+		//	all.
+		if (const TObjectPtr<UMCategoryTabEntryData> AllEntryData = NewObject<UMCategoryTabEntryData>(this))
+		{
+			AllEntryData->Value = INDEX_NONE;
+			AllEntryData->Name = MStringHelper::FindLocTableText(EMLocTableType::UI, TEXT("Collection_Category_All"));
+			AllEntryData->MenuIconType = MenuIconType;
+
+			GradeEntryDatas.Emplace(AllEntryData);
+		}
+
+		//	grade.
+		for (int i = static_cast<int>(EMGrade::Legendary); i >= static_cast<int>(EMGrade::Common); i--)
+		{
+			if (TObjectPtr<UMCategoryTabEntryData> EntryData = NewObject<UMCategoryTabEntryData>(this))
+			{
+				EntryData->Value = i;
+				EntryData->Name = UMDataEnumString::GetGradeString(static_cast<EMGrade>(i));
+				EntryData->MenuIconType = MenuIconType;
+
+				GradeEntryDatas.Emplace(EntryData);
+			}
+		}
+
+		UpdateGradeTabCounts();
+		GradeListView->SetListItems(GradeEntryDatas);
+	}
+
+	UpdateNoIngredientText();
+}
+
+void UMClassSynthesisUI::UpdateGradeTabCounts()
+{
+	// 등급 탭 이름 뒤에 그 등급에서 바로 합성할 수 있는 횟수를 붙인다.
+	bool bChanged = false;
+	for (const TObjectPtr<UMCategoryTabEntryData>& EntryData : GradeEntryDatas)
+	{
+		if (EntryData == nullptr || EntryData->Value == INDEX_NONE)
+		{
+			continue;
+		}
+
+		const EMGrade Grade = static_cast<EMGrade>(EntryData->Value);
+		const int PossibleCount = GetPossibleSynthesisCountOfGrade(Grade);
+
+		FText Name = UMDataEnumString::GetGradeString(Grade);
+		if (PossibleCount > 0)
+		{
+			Name = FText::Format(MStringHelper::FindLocTableText(EMLocTableType::UI, TEXT("Synthesis_UI_GradePossibleCount")), Name, FText::AsNumber(PossibleCount));
+		}
+
+		if (EntryData->Name.EqualTo(Name) == false)
+		{
+			EntryData->Name = Name;
+			bChanged = true;
+		}
+	}
+
+	if (bChanged && GradeListView && GradeListView->GetNumItems() == GradeEntryDatas.Num())
+	{
+		GradeListView->RegenerateAllEntries();
+	}
+}
+
+void UMClassSynthesisUI::PushIngredient(const int InIndex, const int InTID)
+{
+	if (CanPushIngredient(InIndex, InTID) == false)
+	{
+		return;
+	}
+
+	if (GetCurrentSynthesisData() == nullptr)
+	{
+		if (const FMSynthesisData* SynthesisData = GetSynthesisDataFromPawn(InTID))
+		{
+			SetSynthesisData(SynthesisData->ID);
+		}
+	}
+
+	if (SynthesisModel.Push(InIndex, InTID) == false)
+	{
+		return;
+	}
+
+	FlushCharacterCount();
+	UpdateSlot();
+	UpdateSynthesisCount();
+	UpdateSynthesisButton();
+	UpdateCanSynthesisImage();
+}
+
+bool UMClassSynthesisUI::AutoPushIngredient()
+{
+	int SynthesisCount = 0;
+	if (SynthesisTID <= 0)
+	{
+		for (const TPair<int, const FMSynthesisData*> Pair : MDATAMGR->GetSynthesisMap())
+		{
+			SynthesisCount = GetPossibleSynthesisCount(Pair.Key);
+			if (SynthesisCount > 0)
+			{
+				SetSynthesisData(Pair.Key);
+				break;
+			}
+		}
+	}
+	else
+	{
+		SynthesisCount = GetPossibleSynthesisCount(SynthesisTID);
+	}
+
+	if (SynthesisTID <= 0 || SynthesisCount <= 0)
+	{
+		return false;
+	}
+
+	const FMSynthesisData* SynthesisData = GetCurrentSynthesisData();
+	if (SynthesisData == nullptr)
+	{
+		return false;
+	}
+
+	TArray<int> Pawns;
+	if (CharacterList)
+	{
+		Pawns = CharacterList->GetItems();
+	}
+
+	SynthesisModel.AutoPush(Pawns);
+
+	FlushCharacterCount();
+	UpdateSlot();
+	UpdateSynthesisCount();
+	UpdateSynthesisButton();
+	UpdateCanSynthesisImage();
+
+	return true;
+}
+
+int UMClassSynthesisUI::PopIngredient(const int InIndex)
+{
+	const int TID = SynthesisModel.Pop(InIndex);
+	if (TID <= 0)
+	{
+		return 0;
+	}
+
+	FlushCharacterCount();
+	SettingSlotCount();
+	UpdateSlot();
+	UpdateSynthesisCount();
+	UpdateSynthesisButton();
+	UpdateCanSynthesisImage();
+
+	return TID;
+}
+
+void UMClassSynthesisUI::ClearIngredient()
+{
+	SynthesisModel.Clear();
+
+	FlushCharacterCount();
+	SettingSlotCount();
+	UpdateSlot();
+	UpdateSynthesisCount();
+	UpdateSynthesisButton();
+	UpdateCanSynthesisImage();
+}
+
+bool UMClassSynthesisUI::CanPushIngredient(const int InIndex, const int InTID)
+{
+	return SynthesisModel.CanPush(InIndex, InTID);
+}
+
+int UMClassSynthesisUI::GetPossibleSynthesisCount(const int InSynthesisTID) const
+{
+	const FMSynthesisData* SynthesisData = MDATAMGR->GetSynthesisData(InSynthesisTID);
+	if (SynthesisData == nullptr)
+	{
+		return 0;
+	}
+
+	if (PawnType != SynthesisData->PawnType)
+	{
+		return 0;
+	}
+
+	UpdatePossibleSynthesisCounts();
+
+	const int* PossibleCount = PossibleCountCache.Find(InSynthesisTID);
+	return PossibleCount ? *PossibleCount : 0;
+}
+
+int UMClassSynthesisUI::GetPossibleSynthesisCountOfGrade(const EMGrade InGrade) const
+{
+	UpdatePossibleSynthesisCounts();
+
+	const int Grade = static_cast<int>(InGrade);
+	return PossibleCountByGrade.IsValidIndex(Grade) ? PossibleCountByGrade[Grade] : 0;
+}
+
+void UMClassSynthesisUI::UpdatePossibleSynthesisCounts() const
+{
+	if (InventorySnapshot.IsValid() == false)
+	{
+		PossibleCountCache.Reset();
+		PossibleCountByGrade.Reset();
+		PossibleCountCacheVersion = 0;
+		return;
+	}
+
+	// 보유 수량이 바뀌지 않았다면 이전 계산 결과를 그대로 쓴다.
+	if (PossibleCountCacheVersion == InventorySnapshot->GetVersion())
+	{
+		return;
+	}
+
+	TArray<int> SurplusByGrade;
+	InventorySnapshot->GetSurplusByGrade(SurplusByGrade);
+
+	PossibleCountCache.Reset();
+	PossibleCountByGrade.Init(0, SurplusByGrade.Num());
+	PossibleCountCacheVersion = InventorySnapshot->GetVersion();
+
+	for (const TPair<int, const FMSynthesisData*> Pair : MDATAMGR->GetSynthesisMap())
+	{
+		const FMSynthesisData* SynthesisData = Pair.Value;
+		if (SynthesisData->PawnType != PawnType || SynthesisData->MaterialCount <= 0)
+		{
+			continue;
+		}
+
+		const int Grade = static_cast<int>(SynthesisData->Grade);
+		if (SurplusByGrade.IsValidIndex(Grade) == false)
+		{
+			continue;
+		}
+
+		const int PossibleCount = FMath::Min(SurplusByGrade[Grade] / SynthesisData->MaterialCount, MAX_SYNTHESIS_COUNT);
+		PossibleCountCache.Emplace(Pair.Key, PossibleCount);
+		PossibleCountByGrade[Grade] = FMath::Max(PossibleCountByGrade[Grade], PossibleCount);
+	}
+}
+
+bool UMClassSynthesisUI::IsSlotFull(const int InIndex) const
+{
+	return SynthesisModel.IsSlotFull(InIndex);
+}
+
+int UMClassSynthesisUI::GetIngredientCountOfTID(const int InTID) const
+{
+	return SynthesisModel.GetIngredientCountOfTID(InTID);
+}
+
+int UMClassSynthesisUI::GetIngredientCount(const int InIndex) const
+{
+	return SynthesisModel.GetIngredientCount(InIndex);
+}
+
+int UMClassSynthesisUI::GetSlotCount() const
+{
+	return SynthesisModel.GetSlotCount();
+}
+
+int UMClassSynthesisUI::FindPossibleLeastCountSlotIndex() const
+{
+	return SynthesisModel.FindPossibleLeastCountSlotIndex();
+}
+
+int UMClassSynthesisUI::GetCurrentSynthesisCount() const
+{
+	return SynthesisModel.GetCurrentSynthesisCount();
+}
+
+void UMClassSynthesisUI::SettingSlotCount()
+{
+	int SlotCount = GetSlotCount();
+
+	for (int i = 0; i < SynthesisSlots.Num(); i++)
+	{
+		if (SynthesisSlots[i])
+		{
+			SynthesisSlots[i]->SetVisibility(i < SlotCount ? ESlateVisibility::Visible : ESlateVisibility::Collapsed);
+		}
+	}
+
+	UpdateSlot();
+}
+
+void UMClassSynthesisUI::UpdateSlot()
+{
+	for (int i = 0; i < GetSlotCount(); i++)
+	{
+		if (SynthesisSlots.IsValidIndex(i) == false)
+		{
+			continue;
+		}
+
+		const TArray<int>& Ingredients = SynthesisModel.GetIngredients(i);
+		int Count = Ingredients.Num();
+		int Ingredient = Count > 0 ? Ingredients[0] : 0;
+
+		UMPawnIconUI* SynthesisSlot = SynthesisSlots[i];
+		if (SynthesisSlot)
+		{
+			if (Ingredient <= 0)
+			{
+				SynthesisSlot->EmptyIcon();
+			}
+			else
+			{
+				SynthesisSlot->SetItem(Ingredient, false, false, true, Count, false);
+			}
+		}
+	}
+}
+
+void UMClassSynthesisUI::UpdateCharacterCountAll()
+{
+	if (CharacterList)
+	{
+		for (const int TID : CharacterList->GetItems())
+		{
+			UpdateCharacterCountOfTID(TID);
+		}
+	}
+}
+
+void UMClassSynthesisUI::FlushCharacterCount()
+{
+	SynthesisModel.MoveTouchedTIDs(DirtyCountTIDs);
+	if (DirtyCountTIDs.Num() <= 0)
+	{
+		return;
+	}
+
+	TArray<TPair<int, int>> CountDelta;
+	CountDelta.Reserve(DirtyCountTIDs.Num());
+	for (const int TID : DirtyCountTIDs)
+	{
+		CharacterDimmedFilter.Invalidate(EMListFilterDependency::Ingredient, TID);
+		CountDelta.Emplace(TID, GetHaveCount(TID) - GetIngredientCountOfTID(TID) - 1);
+	}
+	DirtyCountTIDs.Reset();
+
+	ApplyCharacterCountDelta(CountDelta);
+}
+
+void UMClassSynthesisUI::ApplyCharacterCountDelta(const TArray<TPair<int, int>>& InCountDelta)
+{
+	if (CharacterList)
+	{
+		for (const TPair<int, int>& Pair : InCountDelta)
+		{
+			CharacterList->SetCharacterCount(Pair.Key, Pair.Value);
+		}
+	}
+}
+
+void UMClassSynthesisUI::UpdateCharacterCountOfTID(const int InTID)
+{
+	if (CharacterList)
+	{
+		int Count = GetHaveCount(InTID) - GetIngredientCountOfTID(InTID) - 1;
+		CharacterList->SetCharacterCount(InTID, Count);
+	}
+}
+
+void UMClassSynthesisUI::UpdateSynthesisCount()
+{
+	if (CountText)
+	{
+		int Count = GetCurrentSynthesisCount();
+		CountText->SetText(FText::AsNumber(Count));
+	}
+}
+
+void UMClassSynthesisUI::UpdateNoIngredientText()
+{
+	if (NoIngredientText)
+	{
+		// 목록 위젯을 다시 훑지 않고 스냅샷의 등급 구간 인덱스로 판단한다.
+		const bool bHasIngredient = InventorySnapshot.IsValid()
+			? GradeListIndex.GetTIDs(*InventorySnapshot, SelectedGrade, CharacterListFilter).Num() > 0
+			: CharacterList && CharacterList->GetAddedItemCount() > 0;
+
+		NoIngredientText->SetVisibility(bHasIngredient ? ESlateVisibility::Collapsed : ESlateVisibility::SelfHitTestInvisible);
+	}
+}
+
+void UMClassSynthesisUI::UpdateProbability()
+{
+	if (ProbabilityText)
+	{
+		const bool bIsActive = GetCurrentSynthesisData() != nullptr;
+
+		ProbabilityText->SetVisibility(bIsActive ? ESlateVisibility::SelfHitTestInvisible : ESlateVisibility::Collapsed);
+
+		if (bIsActive)
+		{
+			const float Probability = GetCurrentSynthesisData()->UpgradeProb / 100.0f;
+			FText Text = FText::Format(MStringHelper::FindLocTableText(EMLocTableType::UI, TEXT("Synthesis_UI_SynthesisProb")), Probability);
+			ProbabilityText->SetText(Text);
+		}
+	}
+
+	RequestSynthesisPreview();
+}
+
+void UMClassSynthesisUI::RequestSynthesisPreview()
+{
+	if (ExpectedResultText == nullptr)
+	{
+		return;
+	}
+
+	const FMSynthesisData* SynthesisData = GetCurrentSynthesisData();
+	if (SynthesisData == nullptr || InventorySnapshot.IsValid() == false)
+	{
+		SynthesisPreviewRequest = 0;
+		ExpectedResultText->SetVisibility(ESlateVisibility::Collapsed);
+		return;
+	}
+
+	// 반복 합성을 끝까지 진행했을 때 상위 등급 획득 수량을 미리 보여준다.
+	FMSynthesisSimulationConfig Config;
+	Config.Recipes.Emplace(FMSynthesisRecipe::FromData(SynthesisTID, *SynthesisData));
+	InventorySnapshot->GetSurplusByGrade(Config.StartSurplusByGrade);
+	Config.MaxRounds = RepeatSynthesisCount * MAX_SYNTHESIS_COUNT;
+	Config.ChainCount = SYNTHESIS_PREVIEW_CHAIN_COUNT;
+	Config.Seed = InventorySnapshot->GetVersion();
+
+	const int Request = ++NextSynthesisPreviewRequest;
+	SynthesisPreviewRequest = Request;
+
+	TWeakObjectPtr<UMClassSynthesisUI> WeakThis(this);
+	FMSynthesisSimulator::SimulateAsync(MoveTemp(Config), [ WeakThis, Request ] (FMSynthesisSimulationResult&& InResult)
+	{
+		if (UMClassSynthesisUI* This = WeakThis.Get())
+		{
+			if (This->SynthesisPreviewRequest == Request)
+			{
+				This->OnSynthesisPreviewCompleted(InResult);
+			}
+		}
+	});
+}
+
+void UMClassSynthesisUI::OnSynthesisPreviewCompleted(const FMSynthesisSimulationResult& InResult)
+{
+	SynthesisPreviewRequest = 0;
+
+	const FMSynthesisData* SynthesisData = GetCurrentSynthesisData();
+	if (ExpectedResultText == nullptr || SynthesisData == nullptr)
+	{
+		return;
+	}
+
+	const int NextGrade = static_cast<int>(SynthesisData->Grade) + 1;
+	const double Mean = InResult.MeanGainByGrade.IsValidIndex(NextGrade) ? InResult.MeanGainByGrade[NextGrade] : 0.0;
+
+	FNumberFormattingOptions Options;
+	Options.MaximumFractionalDigits = 1;
+
+	ExpectedResultText->SetText(FText::Format(MStringHelper::FindLocTableText(EMLocTableType::UI, TEXT("Synthesis_UI_ExpectedResult")), FText::AsNumber(Mean, &Options)));
+	ExpectedResultText->SetVisibility(ESlateVisibility::SelfHitTestInvisible);
+}
+
+void UMClassSynthesisUI::UpdateSynthesisButton()
+{
+	if (SynthesisButtonCover)
+	{
+		SynthesisButtonCover->SetVisibility(CanSynthesis() ? ESlateVisibility::Collapsed : ESlateVisibility::HitTestInvisible);
+	}
+}
+
+void UMClassSynthesisUI::UpdateCanSynthesisImage()
+{
+	if (ImageCanSynthesis)
+	{
+		ImageCanSynthesis->SetVisibility(CanSynthesis() ? ESlateVisibility::HitTestInvisible : ESlateVisibility::Collapsed);
+	}
+
+	if (ImageCanNotSynthesis)
+	{
+		ImageCanNotSynthesis->SetVisibility(!CanSynthesis() ? ESlateVisibility::HitTestInvisible : ESlateVisibility::Collapsed);
+	}
+}
+
+bool UMClassSynthesisUI::CanSynthesis()
+{
+	return GetCurrentSynthesisCount() > 0;
+}
+
+const FMSynthesisData* UMClassSynthesisUI::GetSynthesisDataFromPawn(const int InTID) const
+{
+	FMSynthesisPawnInfo PawnInfo;
+	if (DataProvider.FindPawn(InTID, PawnInfo))
+	{
+		if (const FMSynthesisRecipe* Recipe = DataProvider.FindRecipeOfPawn(PawnInfo))
+		{
+			return MDATAMGR->GetSynthesisData(Recipe->SynthesisTID);
+		}
+	}
+
+	return nullptr;
+}
+
+const FMSynthesisData* UMClassSynthesisUI::GetCurrentSynthesisData() const
+{
+	if (SynthesisTID > 0)
+	{
+		return MDATAMGR->GetSynthesisData(SynthesisTID);
+	}
+	return nullptr;
+}
+
+void UMClassSynthesisUI::SetSynthesisData(const int InTID)
+{
+	if (const FMSynthesisData* Data = MDATAMGR->GetSynthesisData(InTID))
+	{
+		SynthesisTID = InTID;
+		SynthesisModel.SetRecipe(InTID);
+
+		int i;
+		// 합성 데이터가 정해지면 해당 등급 탭으로 강제이동
+		for (i = 1; i < GradeListView->GetNumItems(); i++)
+		{
+			if (UMCategoryTabEntryData* Entry = Cast<UMCategoryTabEntryData>(GradeListView->GetItemAt(i)))
+			{
+				EMGrade Grade = static_cast<EMGrade>(Entry->Value);
+				if (Grade == Data->Grade &&
+					GradeListView->GetSelectedItem<UMCategoryTabEntryData>() != Entry)
+				{
+					break;
+				}
+			}
+		}
+
+		if (i < GradeListView->GetNumItems())
+		{
+			GradeListView->SetSelectedIndex(i);
+		}
+	}
+	else
+	{
+		SynthesisTID = 0;
+		SynthesisModel.SetRecipe(0);
+	}
+
+	SettingSlotCount();
+	UpdateProbability();
+	UpdateSynthesisButton();
+}
+
+void UMClassSynthesisUI::RecvCombineAck(FCombineAckT* InPacket)
+{
+	if (InPacket == nullptr)
+	{
+		return;
+	}
+
+	MCOMBINE_LATENCY_SCOPE(RecvAck);
+
+	if (IsRepeatSynthesis())
+	{
+		RecvRepeatCombineAck(InPacket);
+		return;
+	}
+
+	if (InFlightCombines.Num() <= 0)
+	{
+		return;
+	}
+
+	// 응답이 오면 서버 보유 수량이 갱신되므로 예측 소모량은 되돌린다.
+	FMSynthesisCombineBatch Batch = MoveTemp(InFlightCombines[0]);
+	InFlightCombines.RemoveAt(0);
+	FMCombineLatencyTracker::Get().Record(EMCombineLatencyStage::RoundTrip, FPlatformTime::Seconds() - Batch.SendTime);
+
+	if (InPacket->result != EResultID::R_SUCCESS)
+	{
+		ApplyPredictedConsume(Batch, -1);
+		RestoreIngredient(Batch);
+		return;
+	}
+
+	// 슬롯은 보낼 때 이미 비웠다. 응답을 기다리는 동안 새로 넣은 재료는 그대로 둔다.
+	int PrevTID = SynthesisTID;
+
+	TMap<int32, int> RewardMap;
+	RewardMap.Reserve(InPacket->rewards.size());
+
+	for (const std::shared_ptr<MRewardItemT>& Reward : InPacket->rewards)
+	{
+		if (Reward == nullptr)
+		{
+			continue;
+		}
+
+		int& Count = RewardMap.FindOrAdd(Reward->itemtid);
+		Count += Reward->value;
+	}
+
+	TArray<int> RewardTIDs;
+	RewardMap.GetKeys(RewardTIDs);
+	ApplyPredictedConsume(Batch, -1, RewardTIDs);
+
+	OpenSynthesisReward(RewardMap, PrevTID);
+
+	if (UMClassTabUI* Menubar = Slot->GetTypedOuter<UMClassTabUI>())
+	{
+		Menubar->UpdateRedDot();
+	}
+}
+
+void UMClassSynthesisUI::OpenSynthesisReward(const TMap<int32, int>& InRewardMap, const int InPrevTID)
+{
+	TArray<int> RewardTIDs;
+	InRewardMap.GetKeys(RewardTIDs);
+
+	RewardAssetHandle = FMRewardAssetPrefetcher::Prefetch(RewardTIDs);
+	PendingRewardAssetHandles.Reset();
+
+	// 앞의 연출이 아직 기다리는 중이면 먼저 연다.
+	FlushPendingSynthesisReward();
+
+	// 보상 어셋을 다 읽은 뒤에 연출을 열어 연출 중 동기 로딩으로 끊기지 않게 한다.
+	// 스트리밍이 느려도 MSynthesis.RewardAssetWaitSeconds가 지나면 그대로 연다.
+	UWorld* World = GetWorld();
+	if (World && MClassSynthesis::RewardAssetWaitSeconds > 0.0f && RewardAssetHandle.IsValid() && RewardAssetHandle->HasLoadCompleted() == false && RewardAssetHandle->WasCanceled() == false)
+	{
+		PendingRewardMap = InRewardMap;
+		PendingRewardPrevTID = InPrevTID;
+		bRewardRevealPending = true;
+
+		TWeakObjectPtr<UMClassSynthesisUI> WeakThis(this);
+		const FStreamableDelegate OnLoaded = FStreamableDelegate::CreateLambda([ WeakThis ] ()
+		{
+			if (UMClassSynthesisUI* This = WeakThis.Get())
+			{
+				This->FlushPendingSynthesisReward();
+			}
+		});
+
+		RewardAssetHandle->BindCompleteDelegate(OnLoaded);
+		RewardAssetHandle->BindCancelDelegate(OnLoaded);
+
+		World->GetTimerManager().SetTimer(RewardAssetWaitTimer, FTimerDelegate::CreateUObject(this, &UMClassSynthesisUI::FlushPendingSynthesisReward), MClassSynthesis::RewardAssetWaitSeconds, false);
+		return;
+	}
+
+	OpenSynthesisRewardNow(InRewardMap, InPrevTID);
+}
+
+void UMClassSynthesisUI::FlushPendingSynthesisReward()
+{
+	if (bRewardRevealPending == false)
+	{
+		return;
+	}
+
+	bRewardRevealPending = false;
+
+	if (UWorld* World = GetWorld())
+	{
+		World->GetTimerManager().ClearTimer(RewardAssetWaitTimer);
+	}
+
+	const TMap<int32, int> RewardMap = MoveTemp(PendingRewardMap);
+	PendingRewardMap.Reset();
+
+	OpenSynthesisRewardNow(RewardMap, PendingRewardPrevTID);
+}
+
+void UMClassSynthesisUI::OpenSynthesisRewardNow(const TMap<int32, int>& InRewardMap, const int InPrevTID)
+{
+	EMRewardItemType RewardType = EMRewardItemType::None;
+	if (PawnType == EMPawnType::Hero)
+	{
+		RewardType = EMRewardItemType::Hero;
+	}
+	else if (PawnType == EMPawnType::Pet)
+	{
+		RewardType = EMRewardItemType::Pet;
+	}
+
+	if (RewardType != EMRewardItemType::None)
+	{
+		MCOMBINE_LATENCY_SCOPE(GachaOpen);
+		MUIMGR->GachaUIOpen(EMGachaType::Synthesis, RewardType, InRewardMap, 0);
+		if (UMGachaUI* UI = Cast<UMGachaUI>(MUIMGR->GetOpenUI(TEXT("GachaUI"))))
+		{
+			UI->SetTryAgainCount(GetPossibleSynthesisCount(InPrevTID));
+		}
+	}
+}
+
+bool UMClassSynthesisUI::StartRepeatSynthesis(const int InRepeatCount)
+{
+	// 단일 합성 응답을 기다리는 중에는 시작하지 않는다. 응답 순서가 섞이면 예측 소모량을 되돌릴 배치를 잃는다.
+	if (IsRepeatSynthesis() || InFlightCombines.Num() > 0 || InRepeatCount <= 0)
+	{
+		return false;
+	}
+
+	if (GetCurrentSynthesisData() == nullptr)
+	{
+		for (const TPair<int, const FMSynthesisData*> Pair : MDATAMGR->GetSynthesisMap())
+		{
+			if (GetPossibleSynthesisCount(Pair.Key) > 0)
+			{
+				SetSynthesisData(Pair.Key);
+				break;
+			}
+		}
+	}
+
+	PlannedCombines.Reset();
+	if (PlanCombineBatches(InRepeatCount, PlannedCombines) <= 0)
+	{
+		return false;
+	}
+
+	PendingPlanSteps.Reset();
+	RepeatRewardMap.Reset();
+	LastRepeatCount = InRepeatCount;
+
+	BeginRepeatSynthesis();
+
+	return true;
+}
+
+void UMClassSynthesisUI::BeginRepeatSynthesis()
+{
+	ClearIngredient();
+
+	RepeatSynthesisTID = SynthesisTID;
+
+	SendPlannedCombineBatches();
+}
+
+int UMClassSynthesisUI::PlanCombineBatches(const int InRepeatCount, TArray<FMSynthesisCombineBatch>& OutBatches) const
+{
+	const FMSynthesisData* SynthesisData = GetCurrentSynthesisData();
+	if (SynthesisData == nullptr || SynthesisData->MaterialCount <= 0)
+	{
+		return 0;
+	}
+
+	// 각 TID는 1개씩 남기고 나머지를 재료로 사용한다.
+	if (InventorySnapshot.IsValid() == false)
+	{
+		return 0;
+	}
+
+	const TArray<int>& TIDs = InventorySnapshot->GetTIDs();
+	const TArray<int>& Counts = InventorySnapshot->GetCounts();
+
+	int Begin, End;
+	InventorySnapshot->GetGradeRange(SynthesisData->Grade, Begin, End);
+
+	TArray<TPair<int, int>> Surplus;
+	for (int i = Begin; i < End; i++)
+	{
+		if (Counts[i] > 1)
+		{
+			Surplus.Emplace(TIDs[i], Counts[i] - 1);
+		}
+	}
+
+	return SplitCombineBatches(Surplus, SynthesisData->MaterialCount, InRepeatCount, OutBatches);
+}
+
+int UMClassSynthesisUI::SplitCombineBatches(const TArray<TPair<int, int>>& InIngredients, const int InMaterialCount, const int InMaxBatchCount, TArray<FMSynthesisCombineBatch>& OutBatches)
+{
+	if (InMaterialCount <= 0)
+	{
+		return 0;
+	}
+
+	int Total = 0;
+	for (const TPair<int, int>& Pair : InIngredients)
+	{
+		Total += Pair.Value;
+	}
+
+	const int PrevNum = OutBatches.Num();
+	int Index = 0;
+	int Used = 0;
+	for (int i = 0; i < InMaxBatchCount; i++)
+	{
+		const int SynthesisCount = FMath::Min(Total / InMaterialCount, MAX_SYNTHESIS_COUNT);
+		if (SynthesisCount <= 0)
+		{
+			break;
+		}
+
+		FMSynthesisCombineBatch& Batch = OutBatches.AddDefaulted_GetRef();
+		Batch.SynthesisCount = SynthesisCount;
+
+		int Need = SynthesisCount * InMaterialCount;
+		Total -= Need;
+
+		while (Need > 0 && InIngredients.IsValidIndex(Index))
+		{
+			const int Take = FMath::Min(Need, InIngredients[Index].Value - Used);
+
+			FMSynthesisModel::AddIngredient(Batch.Ingredients, InIngredients[Index].Key, Take);
+			Used += Take;
+			Need -= Take;
+
+			if (Used >= InIngredients[Index].Value)
+			{
+				Index++;
+				Used = 0;
+			}
+		}
+	}
+
+	return OutBatches.Num() - PrevNum;
+}
+
+void UMClassSynthesisUI::SendPlannedCombineBatches()
+{
+	while (PlannedCombines.Num() > 0 && InFlightCombines.Num() < FMath::Max(MaxInFlightCombineCount, 1))
+	{
+		FMSynthesisCombineBatch Batch = MoveTemp(PlannedCombines[0]);
+		PlannedCombines.RemoveAt(0);
+
+		SendCombineBatch(MoveTemp(Batch));
+	}
+}
+
+void UMClassSynthesisUI::FinishRepeatSynthesis()
+{
+	const int PrevTID = RepeatSynthesisTID;
+
+	PlannedCombines.Reset();
+	RepeatSynthesisTID = 0;
+
+	// 전체 합성 계획의 다음 단계가 있으면 보상은 모아두고 이어서 진행한다.
+	if (PendingPlanSteps.Num() > 0 && StartNextPlanStep())
+	{
+		return;
+	}
+
+	if (PlanResultText)
+	{
+		PlanResultText->SetVisibility(ESlateVisibility::Collapsed);
+	}
+
+	ClearIngredient();
+
+	if (RepeatRewardMap.Num() > 0)
+	{
+		const TMap<int32, int> RewardMap = MoveTemp(RepeatRewardMap);
+		RepeatRewardMap.Reset();
+
+		OpenSynthesisReward(RewardMap, PrevTID);
+	}
+}
+
+bool UMClassSynthesisUI::IsRepeatSynthesis() const
+{
+	return RepeatSynthesisTID > 0;
+}
+
+void UMClassSynthesisUI::RecvRepeatCombineAck(FCombineAckT* InPacket)
+{
+	if (InFlightCombines.Num() <= 0)
+	{
+		return;
+	}
+
+	// 서버는 요청 순서대로 응답하므로 가장 먼저 보낸 요청의 응답이다.
+	FMCombineLatencyTracker::Get().Record(EMCombineLatencyStage::RoundTrip, FPlatformTime::Seconds() - InFlightCombines[0].SendTime);
+	const FMSynthesisCombineBatch Batch = MoveTemp(InFlightCombines[0]);
+	InFlightCombines.RemoveAt(0);
+
+	if (InPacket->result == EResultID::R_SUCCESS)
+	{
+		TArray<int> RewardTIDs;
+		for (const std::shared_ptr<MRewardItemT>& Reward : InPacket->rewards)
+		{
+			if (Reward == nullptr)
+			{
+				continue;
+			}
+
+			RepeatRewardMap.FindOrAdd(Reward->itemtid) += Reward->value;
+			RewardTIDs.Emplace(Reward->itemtid);
+		}
+
+		ApplyPredictedConsume(Batch, -1, RewardTIDs);
+
+		if (UMClassTabUI* Menubar = Slot->GetTypedOuter<UMClassTabUI>())
+		{
+			Menubar->UpdateRedDot();
+		}
+
+		// 마지막 응답을 기다리는 동안 이미 받은 보상 어셋을 읽어둔다.
+		if (TSharedPtr<FStreamableHandle> Handle = FMRewardAssetPrefetcher::Prefetch(RewardTIDs))
+		{
+			PendingRewardAssetHandles.Emplace(Handle);
+		}
+	}
+	else
+	{
+		ApplyPredictedConsume(Batch, -1);
+
+		// 실패하면 남은 요청과 남은 계획 단계는 보내지 않고 이미 보낸 요청의 응답만 기다린다.
+		PlannedCombines.Reset();
+		PendingPlanSteps.Reset();
+	}
+
+	SendPlannedCombineBatches();
+
+	if (PlannedCombines.Num() <= 0 && InFlightCombines.Num() <= 0)
+	{
+		FinishRepeatSynthesis();
+	}
+}
+
+void UMClassSynthesisUI::RestoreIngredient(const FMSynthesisCombineBatch& InBatch)
+{
+	if (GetCurrentSynthesisCount() > 0)
+	{
+		return;
+	}
+
+	for (const TPair<int, int>& Pair : InBatch.Ingredients)
+	{
+		for (int i = 0; i < Pair.Value; i++)
+		{
+			const int Index = FindPossibleLeastCountSlotIndex();
+			if (Index < 0)
+			{
+				break;
+			}
+
+			PushIngredient(Index, Pair.Key);
+		}
+	}
+
+	UpdateNoIngredientText();
+}
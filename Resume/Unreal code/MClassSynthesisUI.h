@@ -1,208 +1,401 @@
-/***********************************************************************************
- *                                                                                 *
- * Copyright. (C) 2023 Mobirix.                                                    *
- * Website: https://mobirix.com													   *
- *                                                                                 *
- ***********************************************************************************/
-
-#pragma once
-
-#include "CoreMinimal.h"
-#include "UI/Common/MBaseUIWidget.h"
-#include "MClassSynthesisUI.generated.h"
-
-enum class EMCommonBtnType : uint8;
-class UMCommonBtn;
-class UImage;
-enum class EMPawnType : uint8;
-class UListView;
-class UMCharacterListUI;
-struct FMSynthesisData;
-struct FCombineAckT;
-class UButton;
-class UTextBlock;
-class UMPawnIconUI;
-
-USTRUCT()
-struct FMClassSynthesisSlot
-{
-	GENERATED_BODY()
-
-	int Index;
-
-	TArray<int> Ingredients;
-
-};
-
-UCLASS()
-class MRPG_API UMClassSynthesisUI : public UMBaseUIWidget
-{
-	GENERATED_BODY()
-
-public:
-	virtual void NativeConstruct() override;
-	virtual void NativeDestruct() override;;
-
-	virtual void ReOpenUI(ESlateVisibility InVisibility) override;
-
-private:
-	UFUNCTION()
-	void OnClickedAutoButton(EMCommonBtnType ButtonType);
-
-	UFUNCTION()
-	void OnClockedClearButton(EMCommonBtnType ButtonType);
-
-	UFUNCTION()
-	void OnClickedSynthesisButton(EMCommonBtnType ButtonType);
-
-	UFUNCTION()
-	void OnClickedCharacterListItem(int InTID);
-
-	UFUNCTION()
-	void OnClickedGrade(UObject* InObject);
-
-	// 버튼 배열에 바인드할 마땅한 방법이 없다.
-	UFUNCTION()
-	void OnClickedSlot1();
-
-	UFUNCTION()
-	void OnClickedSlot2();
-
-	UFUNCTION()
-	void OnClickedSlot3();
-
-	UFUNCTION()
-	void OnClickedSlot4();
-
-	UFUNCTION()
-	void OnClickedPopupGachaAgainButton();
-
-	void CreateGradeTab();
-
-	void PushIngredient(int InIndex, const int InTID);
-
-	bool AutoPushIngredient();
-
-	int PopIngredient(int InIndex);
-
-	void ClearIngredient();
-
-	bool CanPushIngredient(int InIndex, const int InTID);
-
-	int GetPossibleSynthesisCount(const int InSynthesisTID) const;
-
-	bool IsSlotFull(int InIndex) const;
-
-	int GetIngredientCountOfTID(const int InTID) const;
-
-	int GetIngredientCount(int InIndex) const;
-
-	int GetSlotCount() const;
-
-	int FindPossibleLeastCountSlotIndex() const;
-
-	int GetCurrentSynthesisCount() const;
-
-	void SettingSlotCount();
-
-	void UpdateSlot();
-
-	void UpdateCharacterCountAll();
-
-	void UpdateCharacterCountOfTID(const int InTID);
-
-	void UpdateSynthesisCount();
-
-	void UpdateNoIngredientText();
-
-	void UpdateProbability();
-
-	void UpdateSynthesisButton();
-
-	void UpdateCanSynthesisImage();
-
-	bool CanSynthesis();
-
-	const FMSynthesisData* GetSynthesisDataFromPawn(const int InTID) const;
-	const FMSynthesisData* GetCurrentSynthesisData() const;
-	void SetSynthesisData(const int InTID);
-
-	void RecvCombineAck(FCombineAckT* InPacket);
-
-
-protected:
-
-	UPROPERTY(Category = UI, BlueprintReadWrite, EditAnywhere, meta = (BindWidgetOptional))
-	TObjectPtr<UMCharacterListUI> CharacterList;
-
-	UPROPERTY(Category = UI, BlueprintReadWrite, EditAnywhere, meta = (BindWidgetOptional))
-	TObjectPtr<UListView> GradeListView;
-
-	UPROPERTY(Category = UI, BlueprintReadWrite, EditAnywhere, meta = (BindWidgetOptional))
-	TObjectPtr<UMPawnIconUI> SynthesisSlot1;
-
-	UPROPERTY(Category = UI, BlueprintReadWrite, EditAnywhere, meta = (BindWidgetOptional))
-	TObjectPtr<UMPawnIconUI> SynthesisSlot2;
-
-	UPROPERTY(Category = UI, BlueprintReadWrite, EditAnywhere, meta = (BindWidgetOptional))
-	TObjectPtr<UMPawnIconUI> SynthesisSlot3;
-
-	UPROPERTY(Category = UI, BlueprintReadWrite, EditAnywhere, meta = (BindWidgetOptional))
-	TObjectPtr<UMPawnIconUI> SynthesisSlot4;
-
-	UPROPERTY(Category = UI, BlueprintReadWrite, EditAnywhere, meta = (BindWidgetOptional))
-	TObjectPtr<UButton> ButtonSlot1;
-
-	UPROPERTY(Category = UI, BlueprintReadWrite, EditAnywhere, meta = (BindWidgetOptional))
-	TObjectPtr<UButton> ButtonSlot2;
-
-	UPROPERTY(Category = UI, BlueprintReadWrite, EditAnywhere, meta = (BindWidgetOptional))
-	TObjectPtr<UButton> ButtonSlot3;
-
-	UPROPERTY(Category = UI, BlueprintReadWrite, EditAnywhere, meta = (BindWidgetOptional))
-	TObjectPtr<UButton> ButtonSlot4;
-
-	UPROPERTY(Category = UI, BlueprintReadWrite, EditAnywhere, meta = (BindWidgetOptional))
-	TObjectPtr<UTextBlock> CountText;
-
-	UPROPERTY(Category = UI, BlueprintReadWrite, EditAnywhere, meta = (BindWidgetOptional))
-	TObjectPtr<UTextBlock> ProbabilityText;
-
-	UPROPERTY(Category = UI, BlueprintReadWrite, EditAnywhere, meta = (BindWidgetOptional))
-	TObjectPtr<UTextBlock> NoIngredientText;
-
-	UPROPERTY(Category = UI, BlueprintReadWrite, EditAnywhere, meta = (BindWidgetOptional))
-	TObjectPtr<UMCommonBtn> ButtonAuto;
-
-	UPROPERTY(Category = UI, BlueprintReadWrite, EditAnywhere, meta = (BindWidgetOptional))
-	TObjectPtr<UMCommonBtn> ButtonClear;
-
-	UPROPERTY(Category = UI, BlueprintReadWrite, EditAnywhere, meta = (BindWidgetOptional))
-	TObjectPtr<UMCommonBtn> ButtonSynthesis;
-
-	UPROPERTY(Category = UI, BlueprintReadWrite, EditAnywhere, meta = (BindWidgetOptional))
-	TObjectPtr<UWidget> SynthesisButtonCover;
-
-	UPROPERTY(Category = UI, BlueprintReadWrite, EditAnywhere, meta = (BindWidgetOptional))
-	TObjectPtr<UImage> ImageCanSynthesis;
-
-	UPROPERTY(Category = UI, BlueprintReadWrite, EditAnywhere, meta = (BindWidgetOptional))
-	TObjectPtr<UImage> ImageCanNotSynthesis;
-
-private:
-	UPROPERTY()
-	TArray<FMClassSynthesisSlot> IngredientSlots;
-
-	UPROPERTY()
-	TMap<int, int> CountMap;
-
-	UPROPERTY()
-	TArray<UMPawnIconUI*> SynthesisSlots;
-
-	UPROPERTY()
-	TArray<UButton*> SlotButtons;
-
-	int SynthesisTID;
-
-	EMPawnType PawnType;
-};
+/***********************************************************************************
+ *                                                                                 *
+ * Copyright. (C) 2023 Mobirix.                                                    *
+ * Website: https://mobirix.com													   *
+ *                                                                                 *
+ ***********************************************************************************/
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "UI/Common/MBaseUIWidget.h"
+#include "Synthesis/MCombineReqBuilder.h"
+#include "Synthesis/MSynthesisListFilter.h"
+#include "Synthesis/MSynthesisPlanner.h"
+#include "Synthesis/MSynthesisProviders.h"
+#include "MClassSynthesisUI.generated.h"
+
+enum class EMCommonBtnType : uint8;
+class UMCommonBtn;
+class UImage;
+enum class EMPawnType : uint8;
+enum class EMGrade : uint8;
+class UListView;
+class UMCharacterListUI;
+class UMCategoryTabEntryData;
+struct FMSynthesisData;
+struct FMPawnInventorySnapshot;
+struct FMSynthesisSimulationResult;
+struct FCombineAckT;
+struct FStreamableHandle;
+class UButton;
+class UTextBlock;
+class UMPawnIconUI;
+
+USTRUCT()
+struct FMSynthesisCombineBatch
+{
+	GENERATED_BODY()
+
+	int SynthesisCount = 0;
+
+	double SendTime = 0.0;
+
+	FMSynthesisIngredientList Ingredients;
+};
+
+UCLASS()
+class MRPG_API UMClassSynthesisUI : public UMBaseUIWidget
+{
+	GENERATED_BODY()
+
+public:
+	virtual void NativeOnInitialized() override;
+	virtual void NativeConstruct() override;
+	virtual void NativeDestruct() override;;
+	virtual void BeginDestroy() override;
+
+	virtual void ReOpenUI(ESlateVisibility InVisibility) override;
+
+private:
+	UFUNCTION()
+	void OnClickedAutoButton(EMCommonBtnType ButtonType);
+
+	UFUNCTION()
+	void OnClockedClearButton(EMCommonBtnType ButtonType);
+
+	UFUNCTION()
+	void OnClickedSynthesisButton(EMCommonBtnType ButtonType);
+
+	UFUNCTION()
+	void OnClickedRepeatSynthesisButton(EMCommonBtnType ButtonType);
+
+	UFUNCTION()
+	void OnClickedSynthesisAllButton(EMCommonBtnType ButtonType);
+
+	UFUNCTION()
+	void OnClickedCharacterListItem(int InTID);
+
+	UFUNCTION()
+	void OnClickedGrade(UObject* InObject);
+
+	// 버튼 배열에 바인드할 마땅한 방법이 없다.
+	UFUNCTION()
+	void OnClickedSlot1();
+
+	UFUNCTION()
+	void OnClickedSlot2();
+
+	UFUNCTION()
+	void OnClickedSlot3();
+
+	UFUNCTION()
+	void OnClickedSlot4();
+
+	UFUNCTION()
+	void OnClickedPopupGachaAgainButton();
+
+	UFUNCTION()
+	void OnSynthesisVisibilityChanged(ESlateVisibility InVisibility);
+
+	void RefreshSynthesisView();
+
+	void CreateGradeTab();
+
+	void PushIngredient(int InIndex, const int InTID);
+
+	bool AutoPushIngredient();
+
+	int PopIngredient(int InIndex);
+
+	void ClearIngredient();
+
+	bool CanPushIngredient(int InIndex, const int InTID);
+
+	int GetPossibleSynthesisCount(const int InSynthesisTID) const;
+
+	int GetPossibleSynthesisCountOfGrade(const EMGrade InGrade) const;
+
+	void UpdateGradeTabCounts();
+
+	void UpdatePossibleSynthesisCounts() const;
+
+	bool IsSlotFull(int InIndex) const;
+
+	int GetIngredientCountOfTID(const int InTID) const;
+
+	int GetIngredientCount(int InIndex) const;
+
+	int GetSlotCount() const;
+
+	int FindPossibleLeastCountSlotIndex() const;
+
+	int GetCurrentSynthesisCount() const;
+
+	void SettingSlotCount();
+
+	void UpdateSlot();
+
+	void UpdateCharacterCountAll();
+
+	void UpdateCharacterCountOfTID(const int InTID);
+
+	void FlushCharacterCount();
+
+	void ApplyCharacterCountDelta(const TArray<TPair<int, int>>& InCountDelta);
+
+	void UpdateSynthesisCount();
+
+	void UpdateNoIngredientText();
+
+	void UpdateProbability();
+
+	void RequestSynthesisPreview();
+
+	void OnSynthesisPreviewCompleted(const FMSynthesisSimulationResult& InResult);
+
+	void UpdateSynthesisButton();
+
+	void UpdateCanSynthesisImage();
+
+	bool CanSynthesis();
+
+	const FMSynthesisData* GetSynthesisDataFromPawn(const int InTID) const;
+	const FMSynthesisData* GetCurrentSynthesisData() const;
+	void SetSynthesisData(const int InTID);
+
+	void RequestSynthesisPlan();
+
+	void OnSynthesisPlanCompleted(FMSynthesisPlan&& InPlan);
+
+	// 남은 계획 단계 중 재료가 있는 첫 단계를 반복 합성으로 시작한다.
+	bool StartNextPlanStep();
+
+	void UpdatePlanResultText(const FMSynthesisPlan& InPlan);
+
+	void SendCombineBatch(FMSynthesisCombineBatch&& InBatch);
+
+	// InRewardTIDs는 응답으로 받은 보상 TID. 재료와 함께 스냅샷에서 수량을 다시 읽는다.
+	void ApplyPredictedConsume(const FMSynthesisCombineBatch& InBatch, const int InSign, const TArray<int>& InRewardTIDs = TArray<int>());
+
+	void RestoreIngredient(const FMSynthesisCombineBatch& InBatch);
+
+	// InDirtyTIDs가 있으면 그 TID의 수량만 이전 스냅샷에 반영한다. 없으면 처음부터 다시 만든다.
+	void RefreshInventorySnapshot(const TArray<int>* InDirtyTIDs = nullptr);
+
+	// 테이블이 다시 읽혔으면 합성 데이터와 그에 기댄 캐시를 다시 만든다.
+	void RefreshSynthesisDataIfStale();
+
+	void RegisterMemoryReporters();
+
+	int GetHaveCount(const int InTID) const;
+
+	bool StartRepeatSynthesis(const int InRepeatCount);
+
+	int PlanCombineBatches(const int InRepeatCount, TArray<FMSynthesisCombineBatch>& OutBatches) const;
+
+	// (TID, 수량) 재료를 한 요청에 최대 합성 횟수만큼씩 나눈다.
+	static int SplitCombineBatches(const TArray<TPair<int, int>>& InIngredients, const int InMaterialCount, const int InMaxBatchCount, TArray<FMSynthesisCombineBatch>& OutBatches);
+
+	// PlannedCombines를 보내기 시작한다.
+	void BeginRepeatSynthesis();
+
+	void SendPlannedCombineBatches();
+
+	void FinishRepeatSynthesis();
+
+	bool IsRepeatSynthesis() const;
+
+	void OpenSynthesisReward(const TMap<int32, int>& InRewardMap, const int InPrevTID);
+
+	void OpenSynthesisRewardNow(const TMap<int32, int>& InRewardMap, const int InPrevTID);
+
+	// 보상 어셋 로딩이 끝나거나 기다림 시간이 지나면 연출을 연다.
+	void FlushPendingSynthesisReward();
+
+	void RecvCombineAck(FCombineAckT* InPacket);
+
+	void RecvRepeatCombineAck(FCombineAckT* InPacket);
+
+
+protected:
+
+	UPROPERTY(Category = UI, BlueprintReadWrite, EditAnywhere, meta = (BindWidgetOptional))
+	TObjectPtr<UMCharacterListUI> CharacterList;
+
+	UPROPERTY(Category = UI, BlueprintReadWrite, EditAnywhere, meta = (BindWidgetOptional))
+	TObjectPtr<UListView> GradeListView;
+
+	UPROPERTY(Category = UI, BlueprintReadWrite, EditAnywhere, meta = (BindWidgetOptional))
+	TObjectPtr<UMPawnIconUI> SynthesisSlot1;
+
+	UPROPERTY(Category = UI, BlueprintReadWrite, EditAnywhere, meta = (BindWidgetOptional))
+	TObjectPtr<UMPawnIconUI> SynthesisSlot2;
+
+	UPROPERTY(Category = UI, BlueprintReadWrite, EditAnywhere, meta = (BindWidgetOptional))
+	TObjectPtr<UMPawnIconUI> SynthesisSlot3;
+
+	UPROPERTY(Category = UI, BlueprintReadWrite, EditAnywhere, meta = (BindWidgetOptional))
+	TObjectPtr<UMPawnIconUI> SynthesisSlot4;
+
+	UPROPERTY(Category = UI, BlueprintReadWrite, EditAnywhere, meta = (BindWidgetOptional))
+	TObjectPtr<UButton> ButtonSlot1;
+
+	UPROPERTY(Category = UI, BlueprintReadWrite, EditAnywhere, meta = (BindWidgetOptional))
+	TObjectPtr<UButton> ButtonSlot2;
+
+	UPROPERTY(Category = UI, BlueprintReadWrite, EditAnywhere, meta = (BindWidgetOptional))
+	TObjectPtr<UButton> ButtonSlot3;
+
+	UPROPERTY(Category = UI, BlueprintReadWrite, EditAnywhere, meta = (BindWidgetOptional))
+	TObjectPtr<UButton> ButtonSlot4;
+
+	UPROPERTY(Category = UI, BlueprintReadWrite, EditAnywhere, meta = (BindWidgetOptional))
+	TObjectPtr<UTextBlock> CountText;
+
+	UPROPERTY(Category = UI, BlueprintReadWrite, EditAnywhere, meta = (BindWidgetOptional))
+	TObjectPtr<UTextBlock> ProbabilityText;
+
+	UPROPERTY(Category = UI, BlueprintReadWrite, EditAnywhere, meta = (BindWidgetOptional))
+	TObjectPtr<UTextBlock> NoIngredientText;
+
+	UPROPERTY(Category = UI, BlueprintReadWrite, EditAnywhere, meta = (BindWidgetOptional))
+	TObjectPtr<UTextBlock> ExpectedResultText;
+
+	// 전체 합성 계획의 기대 결과
+	UPROPERTY(Category = UI, BlueprintReadWrite, EditAnywhere, meta = (BindWidgetOptional))
+	TObjectPtr<UTextBlock> PlanResultText;
+
+	UPROPERTY(Category = UI, BlueprintReadWrite, EditAnywhere, meta = (BindWidgetOptional))
+	TObjectPtr<UMCommonBtn> ButtonAuto;
+
+	UPROPERTY(Category = UI, BlueprintReadWrite, EditAnywhere, meta = (BindWidgetOptional))
+	TObjectPtr<UMCommonBtn> ButtonClear;
+
+	UPROPERTY(Category = UI, BlueprintReadWrite, EditAnywhere, meta = (BindWidgetOptional))
+	TObjectPtr<UMCommonBtn> ButtonSynthesis;
+
+	UPROPERTY(Category = UI, BlueprintReadWrite, EditAnywhere, meta = (BindWidgetOptional))
+	TObjectPtr<UMCommonBtn> ButtonRepeatSynthesis;
+
+	UPROPERTY(Category = UI, BlueprintReadWrite, EditAnywhere, meta = (BindWidgetOptional))
+	TObjectPtr<UMCommonBtn> ButtonSynthesisAll;
+
+	UPROPERTY(Category = UI, BlueprintReadWrite, EditAnywhere, meta = (BindWidgetOptional))
+	TObjectPtr<UWidget> SynthesisButtonCover;
+
+	UPROPERTY(Category = UI, BlueprintReadWrite, EditAnywhere, meta = (BindWidgetOptional))
+	TObjectPtr<UImage> ImageCanSynthesis;
+
+	UPROPERTY(Category = UI, BlueprintReadWrite, EditAnywhere, meta = (BindWidgetOptional))
+	TObjectPtr<UImage> ImageCanNotSynthesis;
+
+	// 반복 합성 시 한번에 계획할 합성 요청 수
+	UPROPERTY(Category = Synthesis, EditAnywhere)
+	int RepeatSynthesisCount = 30;
+
+	// 응답을 기다리지 않고 동시에 보낼 수 있는 합성 요청 수
+	UPROPERTY(Category = Synthesis, EditAnywhere)
+	int MaxInFlightCombineCount = 3;
+
+private:
+	FMSynthesisModel SynthesisModel;
+
+	FMSnapshotInventoryProvider InventoryProvider;
+
+	FMDataManagerSynthesisProvider DataProvider;
+
+	FMCombineReqBuilder CombineReqBuilder;
+
+	// 캐릭터 목록에 넘기는 필터. 결과를 TID별로 기억해두고 입력이 바뀐 TID만 다시 계산한다.
+	FMCachedListFilter CharacterListFilter;
+
+	FMCachedListFilter CharacterDimmedFilter;
+
+	FMSynthesisGradeListIndex GradeListIndex;
+
+	// 선택된 등급 탭. INDEX_NONE이면 전체
+	int SelectedGrade = INDEX_NONE;
+
+	UPROPERTY()
+	TArray<UMPawnIconUI*> SynthesisSlots;
+
+	UPROPERTY()
+	TArray<UButton*> SlotButtons;
+
+	// 열고 닫을 때마다 새로 만들지 않도록 등급 탭 데이터를 재사용한다.
+	UPROPERTY()
+	TArray<TObjectPtr<UMCategoryTabEntryData>> GradeEntryDatas;
+
+	// 보이지 않는 동안 미뤄둔 화면 갱신이 있는지
+	bool bSynthesisViewDirty = false;
+
+	UPROPERTY()
+	TArray<FMSynthesisCombineBatch> PlannedCombines;
+
+	// 전체 합성 계획에서 아직 시작하지 않은 단계. 낮은 등급부터 정렬되어 있다.
+	TArray<FMSynthesisPlanStep> PendingPlanSteps;
+
+	// 계획을 세운 스냅샷 버전
+	uint32 PendingPlanVersion = 0;
+
+	// 서버는 요청을 보낸 순서대로 응답한다. 응답이 오면 맨 앞 배치를 꺼낸다.
+	UPROPERTY()
+	TArray<FMSynthesisCombineBatch> InFlightCombines;
+
+	UPROPERTY()
+	TMap<int, int> RepeatRewardMap;
+
+	// 응답을 기다리는 합성 요청의 재료 소모 예측치
+	UPROPERTY()
+	TMap<int, int> PredictedConsumeMap;
+
+	TSharedPtr<const FMPawnInventorySnapshot> InventorySnapshot;
+
+	// 스냅샷 버전 기준으로 한번에 계산한 합성 TID별, 등급별 가능 횟수
+	mutable TMap<int, int> PossibleCountCache;
+
+	mutable TArray<int> PossibleCountByGrade;
+
+	mutable uint32 PossibleCountCacheVersion = 0;
+
+	// 수량 표시를 갱신해야 하는 TID
+	TSet<int> DirtyCountTIDs;
+
+	// 진행 중인 합성 계획 요청. 0이면 없음
+	int SynthesisPlanRequest = 0;
+
+	int NextSynthesisPlanRequest = 0;
+
+	int SynthesisPreviewRequest = 0;
+
+	int NextSynthesisPreviewRequest = 0;
+
+	TSharedPtr<FStreamableHandle> RewardAssetHandle;
+
+	TSharedPtr<FStreamableHandle> RewardPoolAssetHandle;
+
+	int RewardPoolAssetGrade = 0;
+
+	TArray<TSharedPtr<FStreamableHandle>> PendingRewardAssetHandles;
+
+	// 어셋 로딩을 기다리는 보상 연출
+	TMap<int32, int> PendingRewardMap;
+
+	int PendingRewardPrevTID = 0;
+
+	bool bRewardRevealPending = false;
+
+	FTimerHandle RewardAssetWaitTimer;
+
+	// MMemory.Dump에 합성 화면 상태를 보고하는 리포터
+	TArray<FDelegateHandle> MemoryReporterHandles;
+
+	int RepeatSynthesisTID = 0;
+
+	int LastRepeatCount = 0;
+
+	int SynthesisTID;
+
+	EMPawnType PawnType;
+};
@@ -0,0 +1,105 @@
+/***********************************************************************************
+ *                                                                                 *
+ * Copyright. (C) 2023 Mobirix.                                                    *
+ * Website: https://mobirix.com													   *
+ *                                                                                 *
+ ***********************************************************************************/
+
+
+#include "Synthesis/MCombineLatency.h"
+
+#include "HAL/IConsoleManager.h"
+
+DEFINE_LOG_CATEGORY_STATIC(LogMCombineLatency, Log, All);
+
+namespace MCombineLatency
+{
+	const TCHAR* GetStageName(const int InStage)
+	{
+		switch (static_cast<EMCombineLatencyStage>(InStage))
+		{
+		case EMCombineLatencyStage::BuildRequest:	return TEXT("BuildRequest");
+		case EMCombineLatencyStage::Send:			return TEXT("Send");
+		case EMCombineLatencyStage::RoundTrip:		return TEXT("RoundTrip");
+		case EMCombineLatencyStage::RecvAck:		return TEXT("RecvAck");
+		case EMCombineLatencyStage::GachaOpen:		return TEXT("GachaOpen");
+		default:									return TEXT("Unknown");
+		}
+	}
+
+	FAutoConsoleCommand DumpCommand(
+		TEXT("MSynthesis.DumpCombineLatency"),
+		TEXT("Dump combine request latency histogram per stage."),
+		FConsoleCommandDelegate::CreateLambda([ ] ()
+		{
+			FMCombineLatencyTracker::Get().Dump();
+		}));
+
+	FAutoConsoleCommand ResetCommand(
+		TEXT("MSynthesis.ResetCombineLatency"),
+		TEXT("Reset combine request latency histogram."),
+		FConsoleCommandDelegate::CreateLambda([ ] ()
+		{
+			FMCombineLatencyTracker::Get().Reset();
+		}));
+}
+
+FMCombineLatencyTracker& FMCombineLatencyTracker::Get()
+{
+	static FMCombineLatencyTracker Tracker;
+	return Tracker;
+}
+
+void FMCombineLatencyTracker::Record(const EMCombineLatencyStage InStage, const double InSeconds)
+{
+	check(IsInGameThread());
+
+	const int StageIndex = static_cast<int>(InStage);
+	if (StageIndex < 0 || StageIndex >= static_cast<int>(EMCombineLatencyStage::Max))
+	{
+		return;
+	}
+
+	FStage& Stage = Stages[StageIndex];
+	Stage.Count++;
+	Stage.TotalSeconds += InSeconds;
+	Stage.MaxSeconds = FMath::Max(Stage.MaxSeconds, InSeconds);
+
+	const uint64 Micro = static_cast<uint64>(FMath::Max(InSeconds, 0.0) * 1000000.0);
+	const int Bucket = FMath::Min(Micro > 0 ? static_cast<int>(FMath::FloorLog2_64(Micro)) + 1 : 0, BucketCount - 1);
+	Stage.Buckets[Bucket]++;
+}
+
+void FMCombineLatencyTracker::Reset()
+{
+	for (FStage& Stage : Stages)
+	{
+		Stage = FStage();
+	}
+}
+
+void FMCombineLatencyTracker::Dump() const
+{
+	for (int i = 0; i < static_cast<int>(EMCombineLatencyStage::Max); i++)
+	{
+		const FStage& Stage = Stages[i];
+		if (Stage.Count <= 0)
+		{
+			continue;
+		}
+
+		UE_LOG(LogMCombineLatency, Display, TEXT("%s : count %lld, avg %.3f ms, max %.3f ms"), MCombineLatency::GetStageName(i), Stage.Count, Stage.TotalSeconds * 1000.0 / Stage.Count, Stage.MaxSeconds * 1000.0);
+
+		for (int Bucket = 0; Bucket < BucketCount; Bucket++)
+		{
+			if (Stage.Buckets[Bucket] <= 0)
+			{
+				continue;
+			}
+
+			// 구간 [2^(b-1), 2^b) us
+			const uint64 Upper = 1ull << Bucket;
+			UE_LOG(LogMCombineLatency, Display, TEXT("  < %llu us : %lld"), Upper, Stage.Buckets[Bucket]);
+		}
+	}
+}
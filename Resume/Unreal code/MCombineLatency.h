@@ -0,0 +1,74 @@
+/***********************************************************************************
+ *                                                                                 *
+ * Copyright. (C) 2023 Mobirix.                                                    *
+ * Website: https://mobirix.com													   *
+ *                                                                                 *
+ ***********************************************************************************/
+
+
+#pragma once
+
+#include "CoreMinimal.h"
+
+enum class EMCombineLatencyStage : uint8
+{
+	BuildRequest,
+	Send,
+	RoundTrip,
+	RecvAck,
+	GachaOpen,
+	Max,
+};
+
+// 합성 요청 단계별 소요 시간 분포. 마이크로초 단위 2의 거듭제곱 구간으로 모은다.
+// MSynthesis.DumpCombineLatency / MSynthesis.ResetCombineLatency 콘솔 명령으로 확인한다.
+class MRPG_API FMCombineLatencyTracker
+{
+public:
+	static constexpr int BucketCount = 32;
+
+	static FMCombineLatencyTracker& Get();
+
+	void Record(const EMCombineLatencyStage InStage, const double InSeconds);
+
+	void Reset();
+
+	void Dump() const;
+
+private:
+	struct FStage
+	{
+		int64 Count = 0;
+
+		double TotalSeconds = 0.0;
+
+		double MaxSeconds = 0.0;
+
+		int64 Buckets[BucketCount] = { };
+	};
+
+	FStage Stages[static_cast<int>(EMCombineLatencyStage::Max)];
+};
+
+struct MRPG_API FMCombineLatencyScope
+{
+	explicit FMCombineLatencyScope(const EMCombineLatencyStage InStage)
+		: Stage(InStage)
+		, StartTime(FPlatformTime::Seconds())
+	{
+	}
+
+	~FMCombineLatencyScope()
+	{
+		FMCombineLatencyTracker::Get().Record(Stage, FPlatformTime::Seconds() - StartTime);
+	}
+
+private:
+	EMCombineLatencyStage Stage;
+
+	double StartTime;
+};
+
+#define MCOMBINE_LATENCY_SCOPE(Stage) \
+	TRACE_CPUPROFILER_EVENT_SCOPE(MCombine_##Stage); \
+	FMCombineLatencyScope ANONYMOUS_VARIABLE(CombineLatencyScope)(EMCombineLatencyStage::Stage)
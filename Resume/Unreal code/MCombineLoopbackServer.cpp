@@ -0,0 +1,81 @@
+/***********************************************************************************
+ *                                                                                 *
+ * Copyright. (C) 2023 Mobirix.                                                    *
+ * Website: https://mobirix.com													   *
+ *                                                                                 *
+ ***********************************************************************************/
+
+
+#include "Synthesis/MCombineLoopbackServer.h"
+
+#include "Containers/Ticker.h"
+#include "HAL/IConsoleManager.h"
+#include "Network/MNetworkManager.h"
+
+namespace MCombineLoopback
+{
+	int32 Enabled = 0;
+	FAutoConsoleVariableRef CVarEnabled(TEXT("MSynthesis.CombineLoopback"), Enabled, TEXT("Answer combine requests locally instead of sending them to the server."));
+
+	float LatencyMs = 150.0f;
+	FAutoConsoleVariableRef CVarLatency(TEXT("MSynthesis.CombineLoopbackLatencyMs"), LatencyMs, TEXT("Loopback combine round trip latency in milliseconds."));
+
+	float JitterMs = 50.0f;
+	FAutoConsoleVariableRef CVarJitter(TEXT("MSynthesis.CombineLoopbackJitterMs"), JitterMs, TEXT("Random extra latency in milliseconds."));
+
+	float SuccessRate = 1.0f;
+	FAutoConsoleVariableRef CVarSuccessRate(TEXT("MSynthesis.CombineLoopbackSuccessRate"), SuccessRate, TEXT("Probability that a loopback combine request succeeds."));
+
+	int32 MaterialCount = 4;
+	FAutoConsoleVariableRef CVarMaterialCount(TEXT("MSynthesis.CombineLoopbackMaterialCount"), MaterialCount, TEXT("Ingredients consumed per synthesis round."));
+
+	double LastDueTime = 0.0;
+}
+
+bool FMCombineLoopbackServer::IsEnabled()
+{
+	return MCombineLoopback::Enabled != 0;
+}
+
+void FMCombineLoopbackServer::Send(const FCombineReqT& InReq)
+{
+	using namespace MCombineLoopback;
+
+	int TotalCount = 0;
+	int RewardTID = 0;
+	for (const std::shared_ptr<MItemT>& Item : InReq.items)
+	{
+		if (Item == nullptr)
+		{
+			continue;
+		}
+
+		TotalCount += Item->itemCount;
+		RewardTID = RewardTID > 0 ? RewardTID : Item->itemTID;
+	}
+
+	const bool bSuccess = FMath::FRand() < SuccessRate;
+	const int Rounds = TotalCount / FMath::Max(MaterialCount, 1);
+
+	// 실제 서버처럼 요청 순서대로 응답하도록 이전 응답보다 먼저 도착하지 않게 한다.
+	const double Now = FPlatformTime::Seconds();
+	const double Delay = FMath::Max(LatencyMs + FMath::FRand() * JitterMs, 0.0f) / 1000.0;
+	LastDueTime = FMath::Max(Now + Delay, LastDueTime);
+
+	FTSTicker::GetCoreTicker().AddTicker(FTickerDelegate::CreateLambda([ bSuccess, Rounds, RewardTID ] (float)
+	{
+		FCombineAckT Ack;
+		Ack.result = bSuccess ? EResultID::R_SUCCESS : EResultID::R_FAIL;
+
+		if (bSuccess && Rounds > 0 && RewardTID > 0)
+		{
+			std::shared_ptr<MRewardItemT> Reward = std::make_shared<MRewardItemT>();
+			Reward->itemtid = RewardTID;
+			Reward->value = Rounds;
+			Ack.rewards.push_back(Reward);
+		}
+
+		MNETMGR->OnRecvCombineAck.Broadcast(&Ack);
+		return false;
+	}), static_cast<float>(LastDueTime - Now));
+}
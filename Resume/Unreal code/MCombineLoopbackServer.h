@@ -0,0 +1,24 @@
+/***********************************************************************************
+ *                                                                                 *
+ * Copyright. (C) 2023 Mobirix.                                                    *
+ * Website: https://mobirix.com													   *
+ *                                                                                 *
+ ***********************************************************************************/
+
+
+#pragma once
+
+#include "CoreMinimal.h"
+
+struct FCombineReqT;
+
+// 서버 없이 합성 요청을 시험하기 위한 로컬 대역 서버.
+// MSynthesis.CombineLoopback 1 이면 요청을 서버로 보내지 않고 지정한 지연 후 OnRecvCombineAck로 응답한다.
+// 응답은 요청 순서를 유지하며, 보유 수량은 갱신하지 않는다.
+class MRPG_API FMCombineLoopbackServer
+{
+public:
+	static bool IsEnabled();
+
+	static void Send(const FCombineReqT& InReq);
+};
@@ -0,0 +1,36 @@
+/***********************************************************************************
+ *                                                                                 *
+ * Copyright. (C) 2023 Mobirix.                                                    *
+ * Website: https://mobirix.com													   *
+ *                                                                                 *
+ ***********************************************************************************/
+
+
+#include "Synthesis/MCombineReqBuilder.h"
+
+FCombineReqT& FMCombineReqBuilder::Build(const FMSynthesisIngredientList& InIngredients)
+{
+	Req.items.clear();
+
+	size_t Used = 0;
+	for (const TPair<int, int>& Pair : InIngredients)
+	{
+		if (Pair.Value <= 0)
+		{
+			continue;
+		}
+
+		if (ItemPool.size() <= Used)
+		{
+			ItemPool.push_back(std::make_shared<MItemT>());
+			AllocationCount++;
+		}
+
+		const std::shared_ptr<MItemT>& Ingredient = ItemPool[Used++];
+		Ingredient->itemTID = Pair.Key;
+		Ingredient->itemCount = Pair.Value;
+		Req.items.push_back(Ingredient);
+	}
+
+	return Req;
+}
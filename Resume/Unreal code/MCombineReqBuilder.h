@@ -0,0 +1,32 @@
+/***********************************************************************************
+ *                                                                                 *
+ * Copyright. (C) 2023 Mobirix.                                                    *
+ * Website: https://mobirix.com													   *
+ *                                                                                 *
+ ***********************************************************************************/
+
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Network/MNetworkManager.h"
+#include "Synthesis/MSynthesisModel.h"
+
+// 합성 요청 패킷을 재사용하며 구성한다.
+// 재료 항목 객체는 풀에 남겨 두고 다시 쓰므로, 이전보다 재료 종류가 늘지 않는 한 요청마다 새로 할당하지 않는다.
+// MNETMGR->Send는 호출 시점에 직렬화하므로 다음 Build 전까지만 유효하면 된다.
+class MRPG_API FMCombineReqBuilder
+{
+public:
+	FCombineReqT& Build(const FMSynthesisIngredientList& InIngredients);
+
+	// 지금까지 새로 만든 재료 항목 수
+	int GetAllocationCount() const { return AllocationCount; }
+
+private:
+	FCombineReqT Req;
+
+	std::vector<std::shared_ptr<MItemT>> ItemPool;
+
+	int AllocationCount = 0;
+};
@@ -0,0 +1,54 @@
+/***********************************************************************************
+ *                                                                                 *
+ * Copyright. (C) 2023 Mobirix.                                                    *
+ * Website: https://mobirix.com													   *
+ *                                                                                 *
+ ***********************************************************************************/
+
+
+#include "Misc/AutomationTest.h"
+#include "Synthesis/MCombineReqBuilder.h"
+
+#if WITH_DEV_AUTOMATION_TESTS
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FMCombineReqBuilderAllocationTest, "MRPG.Synthesis.CombineReqBuilder.Allocation", EAutomationTestFlags::ApplicationContextMask | EAutomationTestFlags::ProductFilter)
+
+bool FMCombineReqBuilderAllocationTest::RunTest(const FString& Parameters)
+{
+	FMCombineReqBuilder Builder;
+
+	// 처음 요청에서 재료 종류 수만큼 항목을 만든다. 수량이 0인 재료는 싣지 않는다.
+	FMSynthesisIngredientList Ingredients;
+	Ingredients.Emplace(10, 4);
+	Ingredients.Emplace(11, 2);
+	Ingredients.Emplace(12, 0);
+	Ingredients.Emplace(13, 6);
+
+	FCombineReqT& Req = Builder.Build(Ingredients);
+	TestEqual(TEXT("Items of the first request"), static_cast<int>(Req.items.size()), 3);
+	TestEqual(TEXT("Warm-up allocations"), Builder.GetAllocationCount(), 3);
+
+	const int WarmUpCount = Builder.GetAllocationCount();
+
+	// 재료 종류가 늘지 않는 한 이후 요청은 항목을 새로 만들지 않는다.
+	for (int Request = 0; Request < 100; Request++)
+	{
+		Ingredients.Reset();
+		Ingredients.Emplace(20 + Request, Request % 5 + 1);
+		if (Request % 2 == 0)
+		{
+			Ingredients.Emplace(21 + Request, 1);
+		}
+
+		FCombineReqT& Next = Builder.Build(Ingredients);
+		TestEqual(TEXT("Items"), static_cast<int>(Next.items.size()), Ingredients.Num());
+		TestEqual(TEXT("Item TID"), static_cast<int>(Next.items[0]->itemTID), 20 + Request);
+		TestEqual(TEXT("Item count"), static_cast<int>(Next.items[0]->itemCount), Request % 5 + 1);
+	}
+
+	TestEqual(TEXT("No allocation after warm-up"), Builder.GetAllocationCount(), WarmUpCount);
+
+	return true;
+}
+
+#endif
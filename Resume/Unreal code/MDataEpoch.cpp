@@ -0,0 +1,148 @@
+/***********************************************************************************
+ *                                                                                 *
+ * Copyright. (C) 2023 Mobirix.                                                    *
+ * Website: https://mobirix.com													   *
+ *                                                                                 *
+ ***********************************************************************************/
+
+
+#include "Data/MDataEpoch.h"
+
+#include "HAL/IConsoleManager.h"
+#include <atomic>
+
+DEFINE_LOG_CATEGORY_STATIC(LogMDataEpoch, Log, All);
+
+namespace MDataEpoch
+{
+	constexpr int TableCount = static_cast<int>(EMDataTable::Max);
+
+	// 0은 기록 전을 뜻하므로 1부터 시작한다.
+	std::atomic<uint32> TableEpochs[TableCount] = { 1, 1, 1, 1, 1, 1 };
+
+	std::atomic<uint32> GlobalEpoch { 1 };
+
+	static_assert(TableCount == 6, "Update TableEpochs initializer");
+
+	FAutoConsoleCommand BumpCommand(
+		TEXT("MData.BumpEpoch"),
+		TEXT("Bump the data epoch of a table (Pawn, Item, CustomizingAsset, CustomizingPreset, Transform, Synthesis) or all tables to invalidate derived caches."),
+		FConsoleCommandWithArgsDelegate::CreateLambda([ ] (const TArray<FString>& InArgs)
+		{
+			if (InArgs.Num() <= 0)
+			{
+				FMDataEpoch::BumpAll();
+				UE_LOG(LogMDataEpoch, Display, TEXT("Bumped all tables. Global=%u"), FMDataEpoch::GetGlobal());
+				return;
+			}
+
+			for (int Table = 0; Table < TableCount; Table++)
+			{
+				if (InArgs[0] == FMDataEpoch::GetTableName(static_cast<EMDataTable>(Table)))
+				{
+					FMDataEpoch::Bump(static_cast<EMDataTable>(Table));
+					UE_LOG(LogMDataEpoch, Display, TEXT("Bumped %s=%u Global=%u"), *InArgs[0], FMDataEpoch::Get(static_cast<EMDataTable>(Table)), FMDataEpoch::GetGlobal());
+					return;
+				}
+			}
+
+			UE_LOG(LogMDataEpoch, Warning, TEXT("Unknown table %s"), *InArgs[0]);
+		}));
+}
+
+uint32 FMDataEpoch::Get(const EMDataTable InTable)
+{
+	const int Table = static_cast<int>(InTable);
+	return Table < MDataEpoch::TableCount ? MDataEpoch::TableEpochs[Table].load(std::memory_order_acquire) : 0;
+}
+
+uint32 FMDataEpoch::GetGlobal()
+{
+	return MDataEpoch::GlobalEpoch.load(std::memory_order_acquire);
+}
+
+void FMDataEpoch::Bump(const EMDataTable InTable)
+{
+	const int Table = static_cast<int>(InTable);
+	if (Table >= MDataEpoch::TableCount)
+	{
+		return;
+	}
+
+	// 테이블 세대를 먼저 올려야 전체 세대 변화를 본 쪽이 바뀐 테이블을 놓치지 않는다.
+	MDataEpoch::TableEpochs[Table].fetch_add(1, std::memory_order_acq_rel);
+	MDataEpoch::GlobalEpoch.fetch_add(1, std::memory_order_acq_rel);
+}
+
+void FMDataEpoch::BumpAll()
+{
+	for (int Table = 0; Table < MDataEpoch::TableCount; Table++)
+	{
+		MDataEpoch::TableEpochs[Table].fetch_add(1, std::memory_order_acq_rel);
+	}
+	MDataEpoch::GlobalEpoch.fetch_add(1, std::memory_order_acq_rel);
+}
+
+const TCHAR* FMDataEpoch::GetTableName(const EMDataTable InTable)
+{
+	switch (InTable)
+	{
+	case EMDataTable::Pawn:					return TEXT("Pawn");
+	case EMDataTable::Item:					return TEXT("Item");
+	case EMDataTable::CustomizingAsset:		return TEXT("CustomizingAsset");
+	case EMDataTable::CustomizingPreset:	return TEXT("CustomizingPreset");
+	case EMDataTable::Transform:			return TEXT("Transform");
+	case EMDataTable::Synthesis:			return TEXT("Synthesis");
+	default:								return TEXT("Unknown");
+	}
+}
+
+void FMDataEpochStamp::Capture(std::initializer_list<EMDataTable> InTables)
+{
+	// 전체 세대를 먼저 읽어, 그 사이에 바뀐 테이블은 다음 IsStale에서 잡히게 한다.
+	Global = FMDataEpoch::GetGlobal();
+	TableMask = 0;
+
+	for (const EMDataTable Table : InTables)
+	{
+		const int Index = static_cast<int>(Table);
+		if (Index < MDataEpoch::TableCount)
+		{
+			TableMask |= 1u << Index;
+			Epochs[Index] = FMDataEpoch::Get(Table);
+		}
+	}
+
+	bCaptured = true;
+}
+
+bool FMDataEpochStamp::IsStale() const
+{
+	if (bCaptured == false)
+	{
+		return true;
+	}
+
+	const uint32 CurrentGlobal = FMDataEpoch::GetGlobal();
+	if (CurrentGlobal == Global)
+	{
+		return false;
+	}
+
+	for (int Index = 0; Index < MDataEpoch::TableCount; Index++)
+	{
+		if ((TableMask & (1u << Index)) && Epochs[Index] != FMDataEpoch::Get(static_cast<EMDataTable>(Index)))
+		{
+			return true;
+		}
+	}
+
+	// 의존하지 않는 테이블만 바뀌었다. 다음부터는 다시 빠른 비교로 끝낸다.
+	Global = CurrentGlobal;
+	return false;
+}
+
+void FMDataEpochStamp::Invalidate()
+{
+	bCaptured = false;
+}
@@ -0,0 +1,64 @@
+/***********************************************************************************
+ *                                                                                 *
+ * Copyright. (C) 2023 Mobirix.                                                    *
+ * Website: https://mobirix.com													   *
+ *                                                                                 *
+ ***********************************************************************************/
+
+
+#pragma once
+
+#include "CoreMinimal.h"
+
+// 세대를 따로 관리하는 데이터 테이블
+enum class EMDataTable : uint8
+{
+	Pawn,
+	Item,
+	CustomizingAsset,
+	CustomizingPreset,
+	Transform,
+	Synthesis,
+
+	Max,
+};
+
+// 테이블별 데이터 세대. 테이블을 다시 읽을 때마다 올라가고, 전체 세대는 어느 테이블이든 바뀌면 올라간다.
+// 파생 캐시는 이벤트를 구독하지 않고 만들 때 기록한 값과 비교만 해서 무효화를 판단한다.
+class MRPG_API FMDataEpoch
+{
+public:
+	static uint32 Get(const EMDataTable InTable);
+
+	static uint32 GetGlobal();
+
+	// 테이블을 다시 읽은 쪽(데이터 매니저의 핫 리로드)에서 호출한다.
+	static void Bump(const EMDataTable InTable);
+
+	static void BumpAll();
+
+	static const TCHAR* GetTableName(const EMDataTable InTable);
+};
+
+// 파생 캐시가 의존하는 테이블의 세대 기록.
+// 전체 세대가 그대로면 원자 변수 하나만 읽고 끝난다.
+struct MRPG_API FMDataEpochStamp
+{
+public:
+	// 데이터를 읽기 전에 기록해야 읽는 도중 바뀐 테이블을 놓치지 않는다.
+	void Capture(std::initializer_list<EMDataTable> InTables);
+
+	bool IsStale() const;
+
+	// 다음 IsStale이 무조건 true를 돌려주게 한다.
+	void Invalidate();
+
+private:
+	mutable uint32 Global = 0;
+
+	uint32 Epochs[static_cast<int>(EMDataTable::Max)] = {};
+
+	uint32 TableMask = 0;
+
+	bool bCaptured = false;
+};
@@ -0,0 +1,126 @@
+/***********************************************************************************
+ *                                                                                 *
+ * Copyright. (C) 2023 Mobirix.                                                    *
+ * Website: https://mobirix.com													   *
+ *                                                                                 *
+ ***********************************************************************************/
+
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Algo/BinarySearch.h"
+
+// TID를 키로 하는 읽기 전용 조회 테이블. 로드 시점에 한번 만든다.
+// 레코드는 TID 순으로 연속 배열에 두고, TID 범위가 촘촘하면 (TID - BaseTID) 오프셋 배열로,
+// 아니면 정렬된 TID 배열의 이진 탐색으로 찾는다.
+template <typename RecordType>
+class TMDenseTIDTable
+{
+public:
+	// InMaxSparsity: 레코드 수 대비 허용하는 TID 범위 배수. 넘으면 이진 탐색으로 찾는다.
+	void Build(TArray<TPair<int, RecordType>>&& InRecords, const int InMaxSparsity = 4)
+	{
+		Reset();
+
+		InRecords.Sort([ ] (const TPair<int, RecordType>& A, const TPair<int, RecordType>& B)
+		{
+			return A.Key < B.Key;
+		});
+
+		TIDs.Reserve(InRecords.Num());
+		Records.Reserve(InRecords.Num());
+		for (TPair<int, RecordType>& Pair : InRecords)
+		{
+			// 같은 TID가 여러번 들어오면 앞의 것을 쓴다.
+			if (TIDs.Num() > 0 && TIDs.Last() == Pair.Key)
+			{
+				continue;
+			}
+
+			TIDs.Emplace(Pair.Key);
+			Records.Emplace(MoveTemp(Pair.Value));
+		}
+
+		if (TIDs.Num() <= 0)
+		{
+			return;
+		}
+
+		const int64 Range = static_cast<int64>(TIDs.Last()) - TIDs[0] + 1;
+		if (Range > static_cast<int64>(TIDs.Num()) * FMath::Max(InMaxSparsity, 1))
+		{
+			return;
+		}
+
+		BaseTID = TIDs[0];
+		Slots.Init(INDEX_NONE, static_cast<int32>(Range));
+		for (int i = 0; i < TIDs.Num(); i++)
+		{
+			Slots[TIDs[i] - BaseTID] = i;
+		}
+	}
+
+	// 이미 TID 순으로 정렬된 배열(베이크된 테이블 등)을 그대로 옮긴다.
+	void Assign(TArrayView<const int32> InTIDs, TArrayView<const RecordType> InRecords, const int InBaseTID, TArrayView<const int32> InSlots)
+	{
+		check(InTIDs.Num() == InRecords.Num());
+
+		TIDs = InTIDs;
+		Records = InRecords;
+		Slots = InSlots;
+		BaseTID = InSlots.Num() > 0 ? InBaseTID : 0;
+	}
+
+	const RecordType* Find(const int InTID) const
+	{
+		const int Index = FindIndex(InTID);
+		return Index != INDEX_NONE ? &Records[Index] : nullptr;
+	}
+
+	int FindIndex(const int InTID) const
+	{
+		if (Slots.Num() > 0)
+		{
+			const uint32 Offset = static_cast<uint32>(InTID) - static_cast<uint32>(BaseTID);
+			return Offset < static_cast<uint32>(Slots.Num()) ? Slots[Offset] : INDEX_NONE;
+		}
+
+		return Algo::BinarySearch(TIDs, InTID);
+	}
+
+	void Reset()
+	{
+		TIDs.Reset();
+		Records.Reset();
+		Slots.Reset();
+		BaseTID = 0;
+	}
+
+	int Num() const { return Records.Num(); }
+
+	bool IsDense() const { return Slots.Num() > 0; }
+
+	const TArray<int>& GetTIDs() const { return TIDs; }
+
+	const TArray<RecordType>& GetRecords() const { return Records; }
+
+	const TArray<int32>& GetSlots() const { return Slots; }
+
+	int GetBaseTID() const { return BaseTID; }
+
+	SIZE_T GetAllocatedSize() const
+	{
+		return TIDs.GetAllocatedSize() + Records.GetAllocatedSize() + Slots.GetAllocatedSize();
+	}
+
+private:
+	TArray<int> TIDs;
+
+	TArray<RecordType> Records;
+
+	// 촘촘할 때만 사용. (TID - BaseTID) -> 레코드 인덱스
+	TArray<int32> Slots;
+
+	int BaseTID = 0;
+};
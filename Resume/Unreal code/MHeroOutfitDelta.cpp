@@ -0,0 +1,319 @@
+/***********************************************************************************
+ *                                                                                 *
+ * Copyright. (C) 2023 Mobirix.                                                    *
+ * Website: https://mobirix.com													   *
+ *                                                                                 *
+ ***********************************************************************************/
+
+
+#include "Outfit/MHeroOutfitDelta.h"
+
+#include "Data/MDataManager.h"
+#include "Data/Base/MdataStruct.h"
+#include "Misc/FileHelper.h"
+#include "Network/MNetworkManager.h"
+#include "Outfit/FMHeroOutfit.h"
+
+namespace MHeroOutfitDelta
+{
+	void WriteVarUInt(TArray<uint8>& OutBytes, uint64 InValue)
+	{
+		do
+		{
+			uint8 Byte = static_cast<uint8>(InValue & 0x7F);
+			InValue >>= 7;
+			if (InValue != 0)
+			{
+				Byte |= 0x80;
+			}
+			OutBytes.Emplace(Byte);
+		}
+		while (InValue != 0);
+	}
+
+	bool IsSameOutfit(const FMHeroOutfitData& InA, const FMHeroOutfitData& InB)
+	{
+		return InA.Parts == InB.Parts &&
+			InA.PartEffects == InB.PartEffects &&
+			InA.Materials == InB.Materials;
+	}
+
+	bool ReadVarUInt(const TArray<uint8>& InBytes, int& InOutOffset, uint64& OutValue)
+	{
+		OutValue = 0;
+		for (int Shift = 0; Shift < 64; Shift += 7)
+		{
+			if (InBytes.IsValidIndex(InOutOffset) == false)
+			{
+				return false;
+			}
+
+			const uint8 Byte = InBytes[InOutOffset++];
+			OutValue |= static_cast<uint64>(Byte & 0x7F) << Shift;
+			if ((Byte & 0x80) == 0)
+			{
+				return true;
+			}
+		}
+
+		return false;
+	}
+
+	// TID는 음수가 오지 않지만 0(해제)은 흔하므로 부호 없는 값으로 싣는다.
+	void WriteTID(TArray<uint8>& OutBytes, const int InTID)
+	{
+		WriteVarUInt(OutBytes, static_cast<uint32>(FMath::Max(InTID, 0)));
+	}
+
+	bool ReadTID(const TArray<uint8>& InBytes, int& InOutOffset, int& OutTID)
+	{
+		uint64 Value = 0;
+		if (ReadVarUInt(InBytes, InOutOffset, Value) == false || Value > MAX_int32)
+		{
+			return false;
+		}
+
+		OutTID = static_cast<int>(Value);
+		return true;
+	}
+}
+
+FMHeroOutfitDelta FMHeroOutfitDelta::Diff(const int64 InActorID, const FMHeroOutfitInputs& InPrevious, const FMHeroOutfitInputs& InCurrent)
+{
+	FMHeroOutfitDelta Delta;
+	Delta.ActorID = InActorID;
+	Delta.Inputs = InCurrent;
+
+	if (InPrevious.HeroCostumeTID != InCurrent.HeroCostumeTID)
+	{
+		Delta.Fields |= EMOutfitDeltaField::HeroCostume;
+	}
+
+	if (InPrevious.WeaponCostumeTID != InCurrent.WeaponCostumeTID)
+	{
+		Delta.Fields |= EMOutfitDeltaField::WeaponCostume;
+	}
+
+	if (InPrevious.TransformTID != InCurrent.TransformTID)
+	{
+		Delta.Fields |= EMOutfitDeltaField::Transform;
+	}
+
+	return Delta;
+}
+
+void FMHeroOutfitDelta::Write(TArray<uint8>& OutBytes) const
+{
+	using namespace MHeroOutfitDelta;
+
+	OutBytes.Emplace(static_cast<uint8>(Fields));
+	WriteVarUInt(OutBytes, static_cast<uint64>(ActorID));
+
+	if (EnumHasAnyFlags(Fields, EMOutfitDeltaField::HeroCostume))
+	{
+		WriteTID(OutBytes, Inputs.HeroCostumeTID);
+	}
+
+	if (EnumHasAnyFlags(Fields, EMOutfitDeltaField::WeaponCostume))
+	{
+		WriteTID(OutBytes, Inputs.WeaponCostumeTID);
+	}
+
+	if (EnumHasAnyFlags(Fields, EMOutfitDeltaField::Transform))
+	{
+		WriteTID(OutBytes, Inputs.TransformTID);
+	}
+}
+
+bool FMHeroOutfitDelta::Read(const TArray<uint8>& InBytes, int& InOutOffset)
+{
+	using namespace MHeroOutfitDelta;
+
+	int Offset = InOutOffset;
+	if (InBytes.IsValidIndex(Offset) == false)
+	{
+		return false;
+	}
+
+	*this = FMHeroOutfitDelta();
+	Fields = static_cast<EMOutfitDeltaField>(InBytes[Offset++]);
+
+	uint64 Actor = 0;
+	if (ReadVarUInt(InBytes, Offset, Actor) == false)
+	{
+		return false;
+	}
+	ActorID = static_cast<int64>(Actor);
+
+	if (EnumHasAnyFlags(Fields, EMOutfitDeltaField::HeroCostume) && ReadTID(InBytes, Offset, Inputs.HeroCostumeTID) == false)
+	{
+		return false;
+	}
+
+	if (EnumHasAnyFlags(Fields, EMOutfitDeltaField::WeaponCostume) && ReadTID(InBytes, Offset, Inputs.WeaponCostumeTID) == false)
+	{
+		return false;
+	}
+
+	if (EnumHasAnyFlags(Fields, EMOutfitDeltaField::Transform) && ReadTID(InBytes, Offset, Inputs.TransformTID) == false)
+	{
+		return false;
+	}
+
+	InOutOffset = Offset;
+	return true;
+}
+
+void FMHeroOutfitDelta::ApplyTo(FMHeroOutfitData& InOutfit) const
+{
+	if (IsEmpty())
+	{
+		return;
+	}
+
+	if (EnumHasAnyFlags(Fields, EMOutfitDeltaField::HeroCostume))
+	{
+		const int TID = Inputs.HeroCostumeTID > 0 ? Inputs.HeroCostumeTID : InOutfit.BasePawnTID;
+		InOutfit.OutfitData = MDATAMGR->GetPawnData(TID);
+	}
+
+	if (EnumHasAnyFlags(Fields, EMOutfitDeltaField::WeaponCostume))
+	{
+		InOutfit.WeaponCostumeTID = Inputs.WeaponCostumeTID;
+	}
+
+	if (EnumHasAnyFlags(Fields, EMOutfitDeltaField::Transform))
+	{
+		InOutfit.TransformTID = Inputs.TransformTID;
+	}
+
+	InOutfit.Update();
+}
+
+bool FMHeroOutfitDeltaReplay::LoadSession(const FString& InPath, TArray<FMHeroOutfitDeltaRecord>& OutRecords)
+{
+	// 한 줄에 한 건: ActorID,BasePawnTID,HeroCostumeTID,WeaponCostumeTID,TransformTID. 뒤의 열은 무시한다.
+	TArray<FString> Lines;
+	if (FFileHelper::LoadFileToStringArray(Lines, *InPath) == false)
+	{
+		return false;
+	}
+
+	OutRecords.Reset();
+	for (const FString& Line : Lines)
+	{
+		if (Line.IsEmpty() || Line.StartsWith(TEXT("#")))
+		{
+			continue;
+		}
+
+		TArray<FString> Columns;
+		Line.ParseIntoArray(Columns, TEXT(","));
+		if (Columns.Num() < 5)
+		{
+			continue;
+		}
+
+		FMHeroOutfitDeltaRecord& Record = OutRecords.AddDefaulted_GetRef();
+		LexFromString(Record.ActorID, *Columns[0]);
+		LexFromString(Record.BasePawnTID, *Columns[1]);
+		LexFromString(Record.Inputs.HeroCostumeTID, *Columns[2]);
+		LexFromString(Record.Inputs.WeaponCostumeTID, *Columns[3]);
+		LexFromString(Record.Inputs.TransformTID, *Columns[4]);
+	}
+
+	return true;
+}
+
+void FMHeroOutfitDeltaReplay::Run(const TArray<FMHeroOutfitDeltaRecord>& InRecords, FMHeroOutfitDeltaReplayResult& OutResult)
+{
+	OutResult = FMHeroOutfitDeltaReplayResult();
+
+	// 대역 서버가 기억하는 액터별 마지막 입력
+	TMap<int64, FMHeroOutfitInputs> ServerInputs;
+	TMap<int64, FMHeroOutfitData> FullOutfits;
+	TMap<int64, FMHeroOutfitData> DeltaOutfits;
+
+	// 지금 패킷처럼 두 성별의 커스터마이징을 모두 싣는다.
+	MActorT Actor;
+	for (const int UnitID : { 0, static_cast<int>(EMPCTypeToUnitID::Female) })
+	{
+		std::shared_ptr<MCharacterCustomT> Custom = std::make_shared<MCharacterCustomT>();
+		Custom->pcTypeToUnitID = UnitID;
+		Actor.customInfo.push_back(Custom);
+	}
+
+	TArray<uint8> Bytes;
+	flatbuffers::FlatBufferBuilder Builder;
+	for (int RecordIndex = 0; RecordIndex < InRecords.Num(); RecordIndex++)
+	{
+		const FMHeroOutfitDeltaRecord& Record = InRecords[RecordIndex];
+
+		Actor.actortid = Record.BasePawnTID;
+		Actor.heroCostumeTID = Record.Inputs.HeroCostumeTID;
+		Actor.equipmentCostumeTID = Record.Inputs.WeaponCostumeTID;
+
+		FMHeroOutfitInputs* Previous = ServerInputs.Find(Record.ActorID);
+		if (Previous == nullptr)
+		{
+			// 처음 보는 액터는 양쪽 모두 전체 패킷으로 시작한다.
+			FullOutfits.Add(Record.ActorID).SetFromActorPacket(&Actor);
+			DeltaOutfits.Add(Record.ActorID).SetFromActorPacket(&Actor);
+
+			FMHeroOutfitInputs& Inputs = ServerInputs.Add(Record.ActorID, Record.Inputs);
+			Inputs.TransformTID = 0;
+			continue;
+		}
+
+		const FMHeroOutfitDelta Delta = FMHeroOutfitDelta::Diff(Record.ActorID, *Previous, Record.Inputs);
+		*Previous = Record.Inputs;
+
+		if (Delta.IsEmpty())
+		{
+			continue;
+		}
+
+		OutResult.ChangeCount++;
+
+		// 전체 경로는 대역 액터 패킷을 실제로 직렬화한 크기로 잰다.
+		Builder.Clear();
+		Builder.Finish(MActor::Pack(Builder, &Actor));
+		OutResult.FullBytes += Builder.GetSize();
+
+		double Start = FPlatformTime::Seconds();
+		{
+			FMHeroOutfitData& Outfit = FullOutfits[Record.ActorID];
+			Outfit.SetFromActorPacket(&Actor);
+			if (Record.Inputs.TransformTID > 0)
+			{
+				Outfit.TransformTID = Record.Inputs.TransformTID;
+				Outfit.Update();
+			}
+		}
+		OutResult.FullApplySeconds += FPlatformTime::Seconds() - Start;
+
+		Bytes.Reset();
+		Delta.Write(Bytes);
+		OutResult.DeltaBytes += Bytes.Num();
+
+		Start = FPlatformTime::Seconds();
+		{
+			int Offset = 0;
+			FMHeroOutfitDelta Received;
+			if (Received.Read(Bytes, Offset))
+			{
+				Received.ApplyTo(DeltaOutfits[Record.ActorID]);
+			}
+		}
+		OutResult.DeltaApplySeconds += FPlatformTime::Seconds() - Start;
+
+		if (MHeroOutfitDelta::IsSameOutfit(FullOutfits[Record.ActorID], DeltaOutfits[Record.ActorID]) == false)
+		{
+			OutResult.MismatchCount++;
+			if (OutResult.FirstMismatchRecord == INDEX_NONE)
+			{
+				OutResult.FirstMismatchRecord = RecordIndex;
+			}
+		}
+	}
+}
@@ -0,0 +1,93 @@
+/***********************************************************************************
+ *                                                                                 *
+ * Copyright. (C) 2023 Mobirix.                                                    *
+ * Website: https://mobirix.com													   *
+ *                                                                                 *
+ ***********************************************************************************/
+
+
+#pragma once
+
+#include "CoreMinimal.h"
+
+struct FMHeroOutfitData;
+
+// 의상 변경 메시지에 실리는 필드
+enum class EMOutfitDeltaField : uint8
+{
+	None			= 0,
+	HeroCostume		= 1 << 0,
+	WeaponCostume	= 1 << 1,
+	Transform		= 1 << 2,
+};
+ENUM_CLASS_FLAGS(EMOutfitDeltaField);
+
+// 의상을 정하는 입력 중 서버가 바꿀 수 있는 것. 커스터마이징은 따로 보낸다.
+struct MRPG_API FMHeroOutfitInputs
+{
+	int HeroCostumeTID = 0;
+
+	int WeaponCostumeTID = 0;
+
+	int TransformTID = 0;
+};
+
+// 의상 변경분 메시지. 바뀐 필드 마스크와 새 TID만 가변 길이 정수로 싣는다.
+// 받은 쪽은 ApplyTo로 바뀐 입력만 고치고, 커스터마이징은 다시 해석하지 않는다.
+struct MRPG_API FMHeroOutfitDelta
+{
+	int64 ActorID = 0;
+
+	EMOutfitDeltaField Fields = EMOutfitDeltaField::None;
+
+	FMHeroOutfitInputs Inputs;
+
+	static FMHeroOutfitDelta Diff(const int64 InActorID, const FMHeroOutfitInputs& InPrevious, const FMHeroOutfitInputs& InCurrent);
+
+	bool IsEmpty() const { return Fields == EMOutfitDeltaField::None; }
+
+	void Write(TArray<uint8>& OutBytes) const;
+
+	// 성공하면 InOutOffset을 메시지 끝으로 옮긴다.
+	bool Read(const TArray<uint8>& InBytes, int& InOutOffset);
+
+	// 바뀐 입력만 반영하고 의상을 한번만 다시 계산한다.
+	void ApplyTo(FMHeroOutfitData& InOutfit) const;
+};
+
+// 기록된 세션의 의상 변경 한 건
+struct MRPG_API FMHeroOutfitDeltaRecord
+{
+	int64 ActorID = 0;
+
+	int BasePawnTID = 0;
+
+	FMHeroOutfitInputs Inputs;
+};
+
+struct MRPG_API FMHeroOutfitDeltaReplayResult
+{
+	int ChangeCount = 0;
+
+	int64 FullBytes = 0;
+
+	int64 DeltaBytes = 0;
+
+	double FullApplySeconds = 0.0;
+
+	double DeltaApplySeconds = 0.0;
+
+	// 변경분으로 갱신한 의상이 전체 갱신과 다른 변경 수와 처음 다른 변경의 번호(기록 순서). 없으면 INDEX_NONE
+	int MismatchCount = 0;
+
+	int FirstMismatchRecord = INDEX_NONE;
+};
+
+// 로컬 대역 서버. 기록된 변경을 순서대로 다시 보내며 전체 갱신과 변경분 갱신의 크기/시간을 재고, 두 결과가 같은지 확인한다.
+class MRPG_API FMHeroOutfitDeltaReplay
+{
+public:
+	static bool LoadSession(const FString& InPath, TArray<FMHeroOutfitDeltaRecord>& OutRecords);
+
+	static void Run(const TArray<FMHeroOutfitDeltaRecord>& InRecords, FMHeroOutfitDeltaReplayResult& OutResult);
+};
@@ -0,0 +1,91 @@
+/***********************************************************************************
+ *                                                                                 *
+ * Copyright. (C) 2023 Mobirix.                                                    *
+ * Website: https://mobirix.com													   *
+ *                                                                                 *
+ ***********************************************************************************/
+
+
+#include "Outfit/MHeroOutfitMemory.h"
+
+#include "Core/MMemoryTracker.h"
+#include "Misc/ScopeLock.h"
+#include "Outfit/FMHeroOutfit.h"
+
+namespace MHeroOutfitMemory
+{
+	struct FRegistry
+	{
+		FCriticalSection Lock;
+
+		TSet<const FMHeroOutfitData*> Outfits;
+
+		FDelegateHandle ReporterHandle;
+	};
+
+	// 전역 의상이 정적 초기화/종료 순서와 상관없이 쓸 수 있도록 해제하지 않는다.
+	FRegistry& GetRegistry()
+	{
+		static FRegistry* Registry = new FRegistry();
+		return *Registry;
+	}
+
+	void Report(FMMemoryReport& OutReport)
+	{
+		FRegistry& Registry = GetRegistry();
+		FScopeLock ScopeLock(&Registry.Lock);
+
+		for (const FMHeroOutfitData* Outfit : Registry.Outfits)
+		{
+			OutReport.Add(1, FMHeroOutfitMemory::GetSize(*Outfit));
+		}
+	}
+}
+
+SIZE_T FMHeroOutfitMemory::GetSize(const FMHeroOutfitData& InOutfit)
+{
+	SIZE_T Size = sizeof(FMHeroOutfitData);
+	Size += InOutfit.Parts.GetAllocatedSize();
+	Size += InOutfit.PartEffects.GetAllocatedSize();
+	Size += InOutfit.Materials.GetAllocatedSize();
+
+	for (const FString& Effect : InOutfit.PartEffects)
+	{
+		Size += Effect.GetAllocatedSize();
+	}
+
+	for (const FMHeroCustomizingInfo* Customizing : { &InOutfit.MaleCustomizing, &InOutfit.FemaleCustomizing })
+	{
+		Size += Customizing->CustomMaterials.GetAllocatedSize();
+	}
+
+	return Size;
+}
+
+void FMHeroOutfitMemory::Track(const FMHeroOutfitData* InOutfit)
+{
+	if (InOutfit == nullptr)
+	{
+		return;
+	}
+
+	MHeroOutfitMemory::FRegistry& Registry = MHeroOutfitMemory::GetRegistry();
+	{
+		FScopeLock ScopeLock(&Registry.Lock);
+		Registry.Outfits.Add(InOutfit);
+
+		if (Registry.ReporterHandle.IsValid() == false && IsInGameThread())
+		{
+			Registry.ReporterHandle = FMMemoryTracker::Get().AddReporter(EMMemoryTag::HeroOutfit, FMOnReportMemory::CreateStatic(&MHeroOutfitMemory::Report));
+		}
+	}
+
+	FMMemoryTracker::Get().NoteAllocation(EMMemoryTag::HeroOutfit);
+}
+
+void FMHeroOutfitMemory::Untrack(const FMHeroOutfitData* InOutfit)
+{
+	MHeroOutfitMemory::FRegistry& Registry = MHeroOutfitMemory::GetRegistry();
+	FScopeLock ScopeLock(&Registry.Lock);
+	Registry.Outfits.Remove(InOutfit);
+}
@@ -0,0 +1,27 @@
+/***********************************************************************************
+ *                                                                                 *
+ * Copyright. (C) 2023 Mobirix.                                                    *
+ * Website: https://mobirix.com													   *
+ *                                                                                 *
+ ***********************************************************************************/
+
+
+#pragma once
+
+#include "CoreMinimal.h"
+
+struct FMHeroOutfitData;
+
+// 의상 데이터의 메모리 집계(EMMemoryTag::HeroOutfit).
+// FMHeroOutfitData의 생성자(복사 포함)와 소멸자가 스스로 Track/Untrack하고, 살아있는 의상의 크기는 덤프할 때 모아 계산한다.
+class MRPG_API FMHeroOutfitMemory
+{
+public:
+	// 구조체 자신과 파츠, 이펙트 문자열, 재질, 두 성별 커스터마이징이 잡은 힙을 합친 크기
+	static SIZE_T GetSize(const FMHeroOutfitData& InOutfit);
+
+	// FMHeroOutfitData 생성자와 소멸자에서만 부른다. 어느 스레드에서나 부를 수 있다.
+	static void Track(const FMHeroOutfitData* InOutfit);
+
+	static void Untrack(const FMHeroOutfitData* InOutfit);
+};
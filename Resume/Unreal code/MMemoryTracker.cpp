@@ -0,0 +1,228 @@
+/***********************************************************************************
+ *                                                                                 *
+ * Copyright. (C) 2023 Mobirix.                                                    *
+ * Website: https://mobirix.com													   *
+ *                                                                                 *
+ ***********************************************************************************/
+
+
+#include "Core/MMemoryTracker.h"
+
+#include "HAL/IConsoleManager.h"
+#include "HAL/PlatformFileManager.h"
+#include "Misc/FileHelper.h"
+#include "Misc/Paths.h"
+
+DEFINE_LOG_CATEGORY_STATIC(LogMMemoryTracker, Log, All);
+
+namespace MMemoryTracker
+{
+	FAutoConsoleCommand DumpCommand(
+		TEXT("MMemory.Dump"),
+		TEXT("Dump tagged memory usage of hero outfits and synthesis UI state."),
+		FConsoleCommandDelegate::CreateLambda([ ] ()
+		{
+			FMMemoryTracker::Get().Dump();
+		}));
+
+	FAutoConsoleCommand DumpCsvCommand(
+		TEXT("MMemory.DumpCsv"),
+		TEXT("Append a tagged memory usage sample to a CSV file. Args: [Path] (default Saved/Profiling/MMemory.csv)"),
+		FConsoleCommandWithArgsDelegate::CreateLambda([ ] (const TArray<FString>& InArgs)
+		{
+			const FString Path = InArgs.Num() > 0 ? InArgs[0] : FPaths::ProfilingDir() / TEXT("MMemory.csv");
+			FMMemoryTracker::Get().DumpCsv(Path);
+		}));
+
+	FAutoConsoleCommand ResetPeaksCommand(
+		TEXT("MMemory.ResetPeaks"),
+		TEXT("Reset tagged memory peaks to the current usage."),
+		FConsoleCommandDelegate::CreateLambda([ ] ()
+		{
+			FMMemoryTracker::Get().ResetPeaks();
+		}));
+}
+
+FMMemoryTracker& FMMemoryTracker::Get()
+{
+	static FMMemoryTracker Tracker;
+	return Tracker;
+}
+
+const TCHAR* FMMemoryTracker::GetTagName(const EMMemoryTag InTag)
+{
+	switch (InTag)
+	{
+	case EMMemoryTag::HeroOutfit:			return TEXT("HeroOutfit");
+	case EMMemoryTag::HeroOutfitPreview:	return TEXT("HeroOutfitPreview");
+	case EMMemoryTag::SynthesisModel:		return TEXT("SynthesisModel");
+	case EMMemoryTag::SynthesisCache:		return TEXT("SynthesisCache");
+	case EMMemoryTag::SynthesisUIPool:		return TEXT("SynthesisUIPool");
+	default:								return TEXT("Unknown");
+	}
+}
+
+void FMMemoryTracker::Track(const EMMemoryTag InTag, const int64 InBytes)
+{
+	const int Tag = static_cast<int>(InTag);
+	if (Tag >= TagCount)
+	{
+		return;
+	}
+
+	FCounter& Counter = Counters[Tag];
+	UpdatePeak(Counter.PeakCount, Counter.Count.fetch_add(1, std::memory_order_relaxed) + 1);
+	UpdatePeak(Counter.PeakBytes, Counter.Bytes.fetch_add(InBytes, std::memory_order_relaxed) + InBytes);
+	Counter.TotalAllocations.fetch_add(1, std::memory_order_relaxed);
+}
+
+void FMMemoryTracker::Untrack(const EMMemoryTag InTag, const int64 InBytes)
+{
+	const int Tag = static_cast<int>(InTag);
+	if (Tag >= TagCount)
+	{
+		return;
+	}
+
+	Counters[Tag].Count.fetch_sub(1, std::memory_order_relaxed);
+	Counters[Tag].Bytes.fetch_sub(InBytes, std::memory_order_relaxed);
+}
+
+void FMMemoryTracker::NoteAllocation(const EMMemoryTag InTag)
+{
+	const int Tag = static_cast<int>(InTag);
+	if (Tag < TagCount)
+	{
+		Counters[Tag].TotalAllocations.fetch_add(1, std::memory_order_relaxed);
+	}
+}
+
+FDelegateHandle FMMemoryTracker::AddReporter(const EMMemoryTag InTag, FMOnReportMemory&& InReporter)
+{
+	check(IsInGameThread());
+
+	FReporter& Reporter = Reporters.AddDefaulted_GetRef();
+	Reporter.Tag = InTag;
+	Reporter.Handle = FDelegateHandle(FDelegateHandle::GenerateNewHandle);
+	Reporter.Delegate = MoveTemp(InReporter);
+
+	return Reporter.Handle;
+}
+
+void FMMemoryTracker::RemoveReporter(const FDelegateHandle& InHandle)
+{
+	check(IsInGameThread());
+
+	Reporters.RemoveAllSwap([ &InHandle ] (const FReporter& InReporter)
+	{
+		return InReporter.Handle == InHandle;
+	});
+}
+
+void FMMemoryTracker::Sample(TArray<FStats>& OutStats)
+{
+	check(IsInGameThread());
+
+	OutStats.Reset(TagCount);
+	OutStats.AddDefaulted(TagCount);
+
+	TArray<FMMemoryReport, TInlineAllocator<TagCount>> Reports;
+	Reports.AddDefaulted(TagCount);
+
+	for (const FReporter& Reporter : Reporters)
+	{
+		const int Tag = static_cast<int>(Reporter.Tag);
+		if (Tag < TagCount)
+		{
+			Reporter.Delegate.ExecuteIfBound(Reports[Tag]);
+		}
+	}
+
+	const double Now = FPlatformTime::Seconds();
+	const double Elapsed = LastSampleTime > 0.0 ? Now - LastSampleTime : 0.0;
+
+	for (int Tag = 0; Tag < TagCount; Tag++)
+	{
+		FCounter& Counter = Counters[Tag];
+		FStats& Stats = OutStats[Tag];
+
+		Stats.Count = Counter.Count.load(std::memory_order_relaxed) + Reports[Tag].Count;
+		Stats.Bytes = Counter.Bytes.load(std::memory_order_relaxed) + Reports[Tag].Bytes;
+
+		// 리포터 몫은 샘플할 때만 보이므로 최고치도 여기서 합친다.
+		UpdatePeak(Counter.PeakCount, Stats.Count);
+		UpdatePeak(Counter.PeakBytes, Stats.Bytes);
+		Stats.PeakCount = Counter.PeakCount.load(std::memory_order_relaxed);
+		Stats.PeakBytes = Counter.PeakBytes.load(std::memory_order_relaxed);
+
+		Stats.TotalAllocations = Counter.TotalAllocations.load(std::memory_order_relaxed);
+		Stats.AllocationsPerSecond = Elapsed > 0.0 ? (Stats.TotalAllocations - LastSampleAllocations[Tag]) / Elapsed : 0.0;
+		LastSampleAllocations[Tag] = Stats.TotalAllocations;
+	}
+
+	LastSampleTime = Now;
+}
+
+void FMMemoryTracker::Dump()
+{
+	TArray<FStats> Stats;
+	Sample(Stats);
+
+	UE_LOG(LogMMemoryTracker, Display, TEXT("%-20s %10s %12s %10s %12s %12s %10s"), TEXT("Tag"), TEXT("Count"), TEXT("KB"), TEXT("PeakCount"), TEXT("PeakKB"), TEXT("Allocs"), TEXT("Allocs/s"));
+
+	for (int Tag = 0; Tag < TagCount; Tag++)
+	{
+		const FStats& Tagged = Stats[Tag];
+		UE_LOG(LogMMemoryTracker, Display, TEXT("%-20s %10lld %12.1f %10lld %12.1f %12lld %10.1f"),
+			GetTagName(static_cast<EMMemoryTag>(Tag)), Tagged.Count, Tagged.Bytes / 1024.0, Tagged.PeakCount, Tagged.PeakBytes / 1024.0, Tagged.TotalAllocations, Tagged.AllocationsPerSecond);
+	}
+}
+
+bool FMMemoryTracker::DumpCsv(const FString& InPath)
+{
+	TArray<FStats> Stats;
+	Sample(Stats);
+
+	FString Csv;
+	if (FPlatformFileManager::Get().GetPlatformFile().FileExists(*InPath) == false)
+	{
+		Csv += TEXT("Time,Tag,Count,Bytes,PeakCount,PeakBytes,TotalAllocations,AllocationsPerSecond\n");
+	}
+
+	const FString Time = FDateTime::UtcNow().ToIso8601();
+	for (int Tag = 0; Tag < TagCount; Tag++)
+	{
+		const FStats& Tagged = Stats[Tag];
+		Csv += FString::Printf(TEXT("%s,%s,%lld,%lld,%lld,%lld,%lld,%.2f\n"),
+			*Time, GetTagName(static_cast<EMMemoryTag>(Tag)), Tagged.Count, Tagged.Bytes, Tagged.PeakCount, Tagged.PeakBytes, Tagged.TotalAllocations, Tagged.AllocationsPerSecond);
+	}
+
+	if (FFileHelper::SaveStringToFile(Csv, *InPath, FFileHelper::EEncodingOptions::ForceUTF8WithoutBOM, &IFileManager::Get(), FILEWRITE_Append) == false)
+	{
+		UE_LOG(LogMMemoryTracker, Warning, TEXT("Failed to write %s"), *InPath);
+		return false;
+	}
+
+	UE_LOG(LogMMemoryTracker, Display, TEXT("Wrote memory sample to %s"), *InPath);
+	return true;
+}
+
+void FMMemoryTracker::ResetPeaks()
+{
+	TArray<FStats> Stats;
+	Sample(Stats);
+
+	for (int Tag = 0; Tag < TagCount; Tag++)
+	{
+		Counters[Tag].PeakCount.store(Stats[Tag].Count, std::memory_order_relaxed);
+		Counters[Tag].PeakBytes.store(Stats[Tag].Bytes, std::memory_order_relaxed);
+	}
+}
+
+void FMMemoryTracker::UpdatePeak(std::atomic<int64>& InOutPeak, const int64 InValue)
+{
+	int64 Peak = InOutPeak.load(std::memory_order_relaxed);
+	while (InValue > Peak && InOutPeak.compare_exchange_weak(Peak, InValue, std::memory_order_relaxed) == false)
+	{
+	}
+}
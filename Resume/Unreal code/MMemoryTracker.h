@@ -0,0 +1,126 @@
+/***********************************************************************************
+ *                                                                                 *
+ * Copyright. (C) 2023 Mobirix.                                                    *
+ * Website: https://mobirix.com													   *
+ *                                                                                 *
+ ***********************************************************************************/
+
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include <atomic>
+
+// 메모리 사용량을 따로 집계하는 구조
+enum class EMMemoryTag : uint8
+{
+	HeroOutfit,
+	HeroOutfitPreview,
+	SynthesisModel,
+	SynthesisCache,
+	SynthesisUIPool,
+
+	Max,
+};
+
+// 리포터가 채우는 현재 사용량
+struct FMMemoryReport
+{
+	int64 Count = 0;
+
+	int64 Bytes = 0;
+
+	void Add(const int64 InCount, const int64 InBytes)
+	{
+		Count += InCount;
+		Bytes += InBytes;
+	}
+};
+
+DECLARE_DELEGATE_OneParam(FMOnReportMemory, FMMemoryReport& /*OutReport*/);
+
+// 태그별 메모리 집계.
+// 생성/소멸을 직접 알려주는 카운터(Track/Untrack)와, 덤프할 때 크기를 계산해 주는 리포터를 함께 쓴다.
+// 최고치는 카운터가 바뀔 때와 덤프할 때 갱신하고, 할당 빈도는 이전 덤프 이후 Track 횟수로 계산한다.
+class MRPG_API FMMemoryTracker
+{
+public:
+	static FMMemoryTracker& Get();
+
+	static const TCHAR* GetTagName(const EMMemoryTag InTag);
+
+	// 어느 스레드에서든 부를 수 있다.
+	void Track(const EMMemoryTag InTag, const int64 InBytes);
+
+	void Untrack(const EMMemoryTag InTag, const int64 InBytes);
+
+	// 크기를 따로 관리하지 않고 할당 횟수만 센다.
+	void NoteAllocation(const EMMemoryTag InTag);
+
+	// 리포터는 게임 스레드에서만 등록하고 불린다.
+	FDelegateHandle AddReporter(const EMMemoryTag InTag, FMOnReportMemory&& InReporter);
+
+	void RemoveReporter(const FDelegateHandle& InHandle);
+
+	struct FStats
+	{
+		int64 Count = 0;
+
+		int64 Bytes = 0;
+
+		int64 PeakCount = 0;
+
+		int64 PeakBytes = 0;
+
+		int64 TotalAllocations = 0;
+
+		// 이전 샘플 이후 초당 할당 횟수
+		double AllocationsPerSecond = 0.0;
+	};
+
+	// 리포터를 불러 현재 값을 모으고 최고치와 빈도를 갱신한다.
+	void Sample(TArray<FStats>& OutStats);
+
+	void Dump();
+
+	// 자동화 테스트용. 파일이 없으면 헤더를 쓰고, 있으면 샘플 한 줄씩 덧붙인다.
+	bool DumpCsv(const FString& InPath);
+
+	void ResetPeaks();
+
+private:
+	static constexpr int TagCount = static_cast<int>(EMMemoryTag::Max);
+
+	struct FCounter
+	{
+		std::atomic<int64> Count { 0 };
+
+		std::atomic<int64> Bytes { 0 };
+
+		std::atomic<int64> PeakCount { 0 };
+
+		std::atomic<int64> PeakBytes { 0 };
+
+		std::atomic<int64> TotalAllocations { 0 };
+	};
+
+	struct FReporter
+	{
+		EMMemoryTag Tag = EMMemoryTag::Max;
+
+		FDelegateHandle Handle;
+
+		FMOnReportMemory Delegate;
+	};
+
+	static void UpdatePeak(std::atomic<int64>& InOutPeak, const int64 InValue);
+
+	FCounter Counters[TagCount];
+
+	TArray<FReporter> Reporters;
+
+	// 빈도 계산용 이전 샘플
+	int64 LastSampleAllocations[TagCount] = {};
+
+	double LastSampleTime = 0.0;
+};
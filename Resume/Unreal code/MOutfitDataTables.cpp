@@ -0,0 +1,104 @@
+/***********************************************************************************
+ *                                                                                 *
+ * Copyright. (C) 2023 Mobirix.                                                    *
+ * Website: https://mobirix.com													   *
+ *                                                                                 *
+ ***********************************************************************************/
+
+
+#include "Outfit/MOutfitDataTables.h"
+
+#include "Data/MDataManager.h"
+#include "Data/Base/MdataStruct.h"
+
+namespace MOutfitDataTables
+{
+	template <typename RecordType, typename MapType, typename ConvertType>
+	void BuildTable(TMDenseTIDTable<RecordType>& OutTable, const MapType& InMap, ConvertType&& InConvert)
+	{
+		TArray<TPair<int, RecordType>> Records;
+		Records.Reserve(InMap.Num());
+		for (const auto& Pair : InMap)
+		{
+			if (Pair.Value)
+			{
+				Records.Emplace(Pair.Key, InConvert(*Pair.Value));
+			}
+		}
+
+		OutTable.Build(MoveTemp(Records));
+	}
+}
+
+FMOutfitDataTables& FMOutfitDataTables::Get()
+{
+	static FMOutfitDataTables Tables;
+	return Tables;
+}
+
+void FMOutfitDataTables::RefreshIfStale()
+{
+	check(IsInGameThread());
+
+	if (Epoch.IsStale())
+	{
+		Build();
+	}
+}
+
+void FMOutfitDataTables::Build()
+{
+	TRACE_CPUPROFILER_EVENT_SCOPE(MOutfitDataTables_Build);
+
+	Epoch.Capture({ EMDataTable::CustomizingAsset, EMDataTable::CustomizingPreset, EMDataTable::Item, EMDataTable::Transform });
+
+	MOutfitDataTables::BuildTable(CustomizingAssetMeshes, MDATAMGR->GetCustomizingAssetMap(), [ ] (const FMCustomizingAssetData& InAsset)
+	{
+		return static_cast<int>(InAsset.Mesh);
+	});
+
+	MOutfitDataTables::BuildTable(Items, MDATAMGR->GetItemMap(), [ ] (const FMItemData& InItem)
+	{
+		FMOutfitItemRecord Record;
+		Record.WeaponMeshID = InItem.WeaponMeshID;
+		Record.MaleEffectSocketID = InItem.MaleEffectSocketID;
+		Record.FemaleEffectSocketID = InItem.FemaleEffectSocketID;
+		return Record;
+	});
+
+	MOutfitDataTables::BuildTable(Transforms, MDATAMGR->GetTransformMap(), [ ] (const FMTransformData& InTransform)
+	{
+		FMOutfitTransformRecord Record;
+		Record.UnitIDs = InTransform.UnitID;
+		Record.EquipmentEffectSocketIDs = InTransform.EquipmentEffectSocketID;
+		return Record;
+	});
+
+	ReferencePresets.Reset();
+}
+
+const FMOutfitPresetRecord* FMOutfitDataTables::FindReferencePreset(const FMPawnData& InPawn)
+{
+	check(IsInGameThread());
+
+	const int64 Key = (static_cast<int64>(InPawn.UnitID) << 32) | static_cast<uint32>(InPawn.PawnClass);
+
+	TOptional<FMOutfitPresetRecord>* Found = ReferencePresets.Find(Key);
+	if (Found == nullptr)
+	{
+		Found = &ReferencePresets.Add(Key);
+		if (const FMCustomizingPresetData* Preset = MDATAMGR->GetReferencePresetData(InPawn.UnitID, InPawn.PawnClass))
+		{
+			FMOutfitPresetRecord& Record = Found->Emplace();
+			Record.FaceMesh = Preset->FaceMesh;
+			Record.HairMesh = Preset->HairMesh;
+		}
+	}
+
+	return Found->GetPtrOrNull();
+}
+
+SIZE_T FMOutfitDataTables::GetAllocatedSize() const
+{
+	return CustomizingAssetMeshes.GetAllocatedSize() + Items.GetAllocatedSize() + Transforms.GetAllocatedSize() + ReferencePresets.GetAllocatedSize();
+}
@@ -0,0 +1,79 @@
+/***********************************************************************************
+ *                                                                                 *
+ * Copyright. (C) 2023 Mobirix.                                                    *
+ * Website: https://mobirix.com													   *
+ *                                                                                 *
+ ***********************************************************************************/
+
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Data/MDataEpoch.h"
+#include "Data/MDenseTIDTable.h"
+
+struct FMPawnData;
+
+// 의상 갱신에 쓰는 무기 코스튬 아이템 값
+struct FMOutfitItemRecord
+{
+	int WeaponMeshID = 0;
+
+	FString MaleEffectSocketID;
+
+	FString FemaleEffectSocketID;
+};
+
+// 변신 데이터에서 유닛별 무기 이펙트
+struct FMOutfitTransformRecord
+{
+	TArray<int> UnitIDs;
+
+	TArray<FString> EquipmentEffectSocketIDs;
+};
+
+// 기준 프리셋의 얼굴/머리 커스터마이징 어셋 TID
+struct FMOutfitPresetRecord
+{
+	int FaceMesh = 0;
+
+	int HairMesh = 0;
+};
+
+// 의상 갱신(FMOutfitPartBatch::UpdateOutfits)이 찾는 데이터의 TID 조회 테이블.
+// MDATAMGR 레코드의 주소는 다시 읽으면 사라지므로 들고 있지 않고, 의상 갱신에 쓰는 값만 복사해 둔다.
+// 커스터마이징 어셋, 아이템, 변신 데이터는 처음 쓸 때 한번에 옮기고, 기준 프리셋은 (유닛, 클래스)별로 찾은 결과를 기억한다.
+// 테이블 세대가 바뀌면 다음 갱신에서 다시 만든다. 게임 스레드 전용
+class MRPG_API FMOutfitDataTables
+{
+public:
+	static FMOutfitDataTables& Get();
+
+	// 의상 갱신 전에 부른다. 세대가 그대로면 원자 변수 하나만 읽는다.
+	void RefreshIfStale();
+
+	// 커스터마이징 어셋의 메시 ID
+	const int* FindCustomizingAssetMesh(const int InTID) const { return CustomizingAssetMeshes.Find(InTID); }
+
+	const FMOutfitItemRecord* FindItem(const int InTID) const { return Items.Find(InTID); }
+
+	const FMOutfitTransformRecord* FindTransform(const int InTID) const { return Transforms.Find(InTID); }
+
+	const FMOutfitPresetRecord* FindReferencePreset(const FMPawnData& InPawn);
+
+	SIZE_T GetAllocatedSize() const;
+
+private:
+	void Build();
+
+	TMDenseTIDTable<int> CustomizingAssetMeshes;
+
+	TMDenseTIDTable<FMOutfitItemRecord> Items;
+
+	TMDenseTIDTable<FMOutfitTransformRecord> Transforms;
+
+	// (유닛 ID, 클래스) -> 기준 프리셋. 찾지 못한 결과는 unset으로 기억한다.
+	TMap<int64, TOptional<FMOutfitPresetRecord>> ReferencePresets;
+
+	FMDataEpochStamp Epoch;
+};
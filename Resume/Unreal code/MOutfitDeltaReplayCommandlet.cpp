@@ -0,0 +1,69 @@
+/***********************************************************************************
+ *                                                                                 *
+ * Copyright. (C) 2023 Mobirix.                                                    *
+ * Website: https://mobirix.com													   *
+ *                                                                                 *
+ ***********************************************************************************/
+
+
+#include "Outfit/MOutfitDeltaReplayCommandlet.h"
+
+#include "Outfit/MHeroOutfitDelta.h"
+
+DEFINE_LOG_CATEGORY_STATIC(LogMOutfitDeltaReplay, Log, All);
+
+UMOutfitDeltaReplayCommandlet::UMOutfitDeltaReplayCommandlet()
+{
+	IsClient = false;
+	IsServer = false;
+	IsEditor = false;
+	LogToConsole = true;
+}
+
+int32 UMOutfitDeltaReplayCommandlet::Main(const FString& Params)
+{
+	FString Session;
+	int Repeat = 1;
+	FParse::Value(*Params, TEXT("Session="), Session);
+	FParse::Value(*Params, TEXT("Repeat="), Repeat);
+
+	TArray<FMHeroOutfitDeltaRecord> Records;
+	if (Session.IsEmpty() || FMHeroOutfitDeltaReplay::LoadSession(Session, Records) == false)
+	{
+		UE_LOG(LogMOutfitDeltaReplay, Error, TEXT("Cannot read session %s"), *Session);
+		return 1;
+	}
+
+	FMHeroOutfitDeltaReplayResult Total;
+	for (int i = 0; i < FMath::Max(Repeat, 1); i++)
+	{
+		FMHeroOutfitDeltaReplayResult Result;
+		FMHeroOutfitDeltaReplay::Run(Records, Result);
+
+		Total.ChangeCount += Result.ChangeCount;
+		Total.FullBytes += Result.FullBytes;
+		Total.DeltaBytes += Result.DeltaBytes;
+		Total.FullApplySeconds += Result.FullApplySeconds;
+		Total.DeltaApplySeconds += Result.DeltaApplySeconds;
+		Total.MismatchCount += Result.MismatchCount;
+
+		if (Total.FirstMismatchRecord == INDEX_NONE)
+		{
+			Total.FirstMismatchRecord = Result.FirstMismatchRecord;
+		}
+	}
+
+	const double Changes = FMath::Max(Total.ChangeCount, 1);
+	UE_LOG(LogMOutfitDeltaReplay, Display, TEXT("Records=%d Changes=%d"), Records.Num(), Total.ChangeCount);
+	UE_LOG(LogMOutfitDeltaReplay, Display, TEXT("Bytes/change : full %.1f, delta %.1f"), Total.FullBytes / Changes, Total.DeltaBytes / Changes);
+	UE_LOG(LogMOutfitDeltaReplay, Display, TEXT("Apply/change : full %.2f us, delta %.2f us"), Total.FullApplySeconds * 1000000.0 / Changes, Total.DeltaApplySeconds * 1000000.0 / Changes);
+
+	if (Total.MismatchCount > 0)
+	{
+		const FMHeroOutfitDeltaRecord& First = Records[Total.FirstMismatchRecord];
+		UE_LOG(LogMOutfitDeltaReplay, Error, TEXT("Delta outfit differs from full outfit in %d changes. First at record %d (Actor %lld)"), Total.MismatchCount, Total.FirstMismatchRecord, First.ActorID);
+		return 1;
+	}
+
+	return 0;
+}
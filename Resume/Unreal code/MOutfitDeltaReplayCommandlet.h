@@ -0,0 +1,26 @@
+/***********************************************************************************
+ *                                                                                 *
+ * Copyright. (C) 2023 Mobirix.                                                    *
+ * Website: https://mobirix.com													   *
+ *                                                                                 *
+ ***********************************************************************************/
+
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Commandlets/Commandlet.h"
+#include "MOutfitDeltaReplayCommandlet.generated.h"
+
+// 기록된 세션의 의상 변경을 다시 보내 전체 갱신과 변경분 갱신의 크기/클라이언트 시간을 비교한다.
+// 예) -run=MOutfitDeltaReplay -Session=Saved/OutfitSession.csv -Repeat=10
+UCLASS()
+class MRPG_API UMOutfitDeltaReplayCommandlet : public UCommandlet
+{
+	GENERATED_BODY()
+
+public:
+	UMOutfitDeltaReplayCommandlet();
+
+	virtual int32 Main(const FString& Params) override;
+};
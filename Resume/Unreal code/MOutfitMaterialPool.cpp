@@ -0,0 +1,247 @@
+/***********************************************************************************
+ *                                                                                 *
+ * Copyright. (C) 2023 Mobirix.                                                    *
+ * Website: https://mobirix.com													   *
+ *                                                                                 *
+ ***********************************************************************************/
+
+
+#include "Outfit/MOutfitMaterialPool.h"
+
+#include "HAL/IConsoleManager.h"
+#include "Materials/MaterialInstanceDynamic.h"
+
+DEFINE_LOG_CATEGORY_STATIC(LogMOutfitMaterialPool, Log, All);
+
+namespace MOutfitMaterialPool
+{
+	int32 Enabled = 1;
+	FAutoConsoleVariableRef CVarEnabled(TEXT("MOutfit.MaterialPool"), Enabled, TEXT("Share outfit dynamic material instances with identical parameters."));
+
+	int32 MaxFree = 64;
+	FAutoConsoleVariableRef CVarMaxFree(TEXT("MOutfit.MaterialPoolMaxFree"), MaxFree, TEXT("Number of unused outfit material instances kept for reuse."));
+
+	FAutoConsoleCommand DumpCommand(
+		TEXT("MOutfit.DumpMaterialPool"),
+		TEXT("Dump outfit material instance pool counters."),
+		FConsoleCommandDelegate::CreateLambda([ ] ()
+		{
+			FMOutfitMaterialPool::Get().Dump();
+		}));
+}
+
+void FMOutfitMaterialParams::SetScalar(const FName InName, const float InValue)
+{
+	for (TPair<FName, float>& Pair : Scalars)
+	{
+		if (Pair.Key == InName)
+		{
+			Pair.Value = InValue;
+			return;
+		}
+	}
+
+	Scalars.Emplace(InName, InValue);
+}
+
+void FMOutfitMaterialParams::SetVector(const FName InName, const FLinearColor& InValue)
+{
+	for (TPair<FName, FLinearColor>& Pair : Vectors)
+	{
+		if (Pair.Key == InName)
+		{
+			Pair.Value = InValue;
+			return;
+		}
+	}
+
+	Vectors.Emplace(InName, InValue);
+}
+
+void FMOutfitMaterialParams::Canonicalize()
+{
+	Scalars.Sort([ ] (const TPair<FName, float>& A, const TPair<FName, float>& B)
+	{
+		return A.Key.FastLess(B.Key);
+	});
+
+	Vectors.Sort([ ] (const TPair<FName, FLinearColor>& A, const TPair<FName, FLinearColor>& B)
+	{
+		return A.Key.FastLess(B.Key);
+	});
+}
+
+void FMOutfitMaterialParams::ApplyTo(UMaterialInstanceDynamic* InInstance) const
+{
+	if (InInstance == nullptr)
+	{
+		return;
+	}
+
+	for (const TPair<FName, float>& Pair : Scalars)
+	{
+		InInstance->SetScalarParameterValue(Pair.Key, Pair.Value);
+	}
+
+	for (const TPair<FName, FLinearColor>& Pair : Vectors)
+	{
+		InInstance->SetVectorParameterValue(Pair.Key, Pair.Value);
+	}
+}
+
+bool FMOutfitMaterialParams::operator==(const FMOutfitMaterialParams& InOther) const
+{
+	return Scalars == InOther.Scalars && Vectors == InOther.Vectors;
+}
+
+uint32 GetTypeHash(const FMOutfitMaterialParams& InParams)
+{
+	uint32 Hash = 0;
+	for (const TPair<FName, float>& Pair : InParams.Scalars)
+	{
+		Hash = HashCombine(Hash, HashCombine(GetTypeHash(Pair.Key), GetTypeHash(Pair.Value)));
+	}
+
+	for (const TPair<FName, FLinearColor>& Pair : InParams.Vectors)
+	{
+		Hash = HashCombine(Hash, HashCombine(GetTypeHash(Pair.Key), GetTypeHash(Pair.Value)));
+	}
+
+	return Hash;
+}
+
+FMOutfitMaterialPool& FMOutfitMaterialPool::Get()
+{
+	static FMOutfitMaterialPool Pool;
+	return Pool;
+}
+
+UMaterialInstanceDynamic* FMOutfitMaterialPool::Acquire(UMaterialInterface* InParent, const FMOutfitMaterialParams& InParams)
+{
+	if (InParent == nullptr)
+	{
+		return nullptr;
+	}
+
+	AcquireCount++;
+
+	FKey Key;
+	Key.Parent = InParent;
+	Key.Params = InParams;
+	Key.Params.Canonicalize();
+
+	if (MOutfitMaterialPool::Enabled == 0)
+	{
+		UMaterialInstanceDynamic* Instance = UMaterialInstanceDynamic::Create(InParent, GetTransientPackage());
+		Key.Params.ApplyTo(Instance);
+		CreatedCount++;
+		return Instance;
+	}
+
+	if (FEntry* Entry = Entries.Find(Key))
+	{
+		Entry->RefCount++;
+		SharedCount++;
+		return Entry->Instance.Get();
+	}
+
+	UMaterialInstanceDynamic* Instance = nullptr;
+
+	// 같은 부모 재질의 쉬는 인스턴스가 있으면 파라미터만 바꿔 쓴다.
+	if (TArray<TStrongObjectPtr<UMaterialInstanceDynamic>>* Free = FreeInstances.Find(Key.Parent))
+	{
+		while (Free->Num() > 0 && Instance == nullptr)
+		{
+			Instance = Free->Last().Get();
+			Free->RemoveAt(Free->Num() - 1, 1, false);
+			FreeCount--;
+		}
+
+		if (Instance)
+		{
+			Instance->ClearParameterValues();
+			ReusedCount++;
+		}
+	}
+
+	if (Instance == nullptr)
+	{
+		const double Start = FPlatformTime::Seconds();
+		Instance = UMaterialInstanceDynamic::Create(InParent, GetTransientPackage());
+		CreateSeconds += FPlatformTime::Seconds() - Start;
+		CreatedCount++;
+	}
+
+	Key.Params.ApplyTo(Instance);
+
+	FEntry& Entry = Entries.Add(Key);
+	Entry.Instance.Reset(Instance);
+	Entry.RefCount = 1;
+	KeyOfInstance.Emplace(Instance, Key);
+
+	return Instance;
+}
+
+void FMOutfitMaterialPool::Release(UMaterialInstanceDynamic* InInstance)
+{
+	const FKey* KeyPtr = KeyOfInstance.Find(InInstance);
+	if (KeyPtr == nullptr)
+	{
+		return;
+	}
+
+	const FKey Key = *KeyPtr;
+	FEntry* Entry = Entries.Find(Key);
+	if (Entry == nullptr)
+	{
+		KeyOfInstance.Remove(InInstance);
+		return;
+	}
+
+	if (--Entry->RefCount > 0)
+	{
+		return;
+	}
+
+	if (FreeCount < MOutfitMaterialPool::MaxFree && Key.Parent.IsValid())
+	{
+		FreeInstances.FindOrAdd(Key.Parent).Emplace(MoveTemp(Entry->Instance));
+		FreeCount++;
+	}
+
+	Entries.Remove(Key);
+	KeyOfInstance.Remove(InInstance);
+}
+
+UMaterialInstanceDynamic* FMOutfitMaterialPool::Exchange(UMaterialInstanceDynamic* InPrevious, UMaterialInterface* InParent, const FMOutfitMaterialParams& InParams)
+{
+	// 같은 키면 참조 수만 그대로 유지되고, 다르면 놓은 인스턴스를 바로 다시 쓸 수 있다.
+	UMaterialInstanceDynamic* Instance = Acquire(InParent, InParams);
+	Release(InPrevious);
+
+	return Instance;
+}
+
+void FMOutfitMaterialPool::Reset()
+{
+	Entries.Reset();
+	KeyOfInstance.Reset();
+	FreeInstances.Reset();
+	FreeCount = 0;
+}
+
+void FMOutfitMaterialPool::Dump() const
+{
+	int InUse = 0;
+	for (const TPair<FKey, FEntry>& Pair : Entries)
+	{
+		InUse += Pair.Value.RefCount;
+	}
+
+	const double AverageCreateSeconds = CreatedCount > 0 ? CreateSeconds / CreatedCount : 0.0;
+	const double SavedSeconds = AverageCreateSeconds * static_cast<double>(SharedCount + ReusedCount);
+
+	UE_LOG(LogMOutfitMaterialPool, Display, TEXT("Outfit material pool: Instances=%d Users=%d Free=%d"), Entries.Num(), InUse, FreeCount);
+	UE_LOG(LogMOutfitMaterialPool, Display, TEXT("Acquire=%lld Shared=%lld Reused=%lld Created=%lld"), AcquireCount, SharedCount, ReusedCount, CreatedCount);
+	UE_LOG(LogMOutfitMaterialPool, Display, TEXT("Create %.3f ms total (%.1f us avg), saved about %.3f ms"), CreateSeconds * 1000.0, AverageCreateSeconds * 1000000.0, SavedSeconds * 1000.0);
+}
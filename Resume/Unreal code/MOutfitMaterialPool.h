@@ -0,0 +1,94 @@
+/***********************************************************************************
+ *                                                                                 *
+ * Copyright. (C) 2023 Mobirix.                                                    *
+ * Website: https://mobirix.com													   *
+ *                                                                                 *
+ ***********************************************************************************/
+
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "UObject/StrongObjectPtr.h"
+
+class UMaterialInstanceDynamic;
+class UMaterialInterface;
+
+// 의상 재질 파라미터 묶음. Canonicalize 후에는 넣은 순서와 상관없이 같은 값이면 같은 키가 된다.
+struct MRPG_API FMOutfitMaterialParams
+{
+	TArray<TPair<FName, float>, TInlineAllocator<4>> Scalars;
+
+	TArray<TPair<FName, FLinearColor>, TInlineAllocator<4>> Vectors;
+
+	void SetScalar(const FName InName, const float InValue);
+
+	void SetVector(const FName InName, const FLinearColor& InValue);
+
+	void Canonicalize();
+
+	void ApplyTo(UMaterialInstanceDynamic* InInstance) const;
+
+	bool operator==(const FMOutfitMaterialParams& InOther) const;
+
+	friend uint32 GetTypeHash(const FMOutfitMaterialParams& InParams);
+};
+
+// 같은 부모 재질과 파라미터를 쓰는 액터끼리 다이나믹 머티리얼 인스턴스를 나눠 쓴다.
+// 아무도 쓰지 않게 된 인스턴스는 바로 버리지 않고 같은 부모 재질의 다른 파라미터 요청에 다시 쓴다.
+// MOutfit.DumpMaterialPool 콘솔 명령으로 인스턴스 수와 아낀 생성 시간을 확인한다.
+class MRPG_API FMOutfitMaterialPool
+{
+public:
+	static FMOutfitMaterialPool& Get();
+
+	// 돌려받은 인스턴스는 공유되므로 파라미터를 직접 바꾸지 않는다. 다 쓰면 Release한다.
+	UMaterialInstanceDynamic* Acquire(UMaterialInterface* InParent, const FMOutfitMaterialParams& InParams);
+
+	void Release(UMaterialInstanceDynamic* InInstance);
+
+	// 의상이 바뀔 때 새 인스턴스를 먼저 얻고 이전 것을 놓는다.
+	UMaterialInstanceDynamic* Exchange(UMaterialInstanceDynamic* InPrevious, UMaterialInterface* InParent, const FMOutfitMaterialParams& InParams);
+
+	void Reset();
+
+	void Dump() const;
+
+private:
+	struct FKey
+	{
+		TWeakObjectPtr<UMaterialInterface> Parent;
+
+		FMOutfitMaterialParams Params;
+
+		bool operator==(const FKey& InOther) const { return Parent == InOther.Parent && Params == InOther.Params; }
+
+		friend uint32 GetTypeHash(const FKey& InKey) { return HashCombine(GetTypeHash(InKey.Parent), GetTypeHash(InKey.Params)); }
+	};
+
+	struct FEntry
+	{
+		TStrongObjectPtr<UMaterialInstanceDynamic> Instance;
+
+		int RefCount = 0;
+	};
+
+	TMap<FKey, FEntry> Entries;
+
+	TMap<UMaterialInstanceDynamic*, FKey> KeyOfInstance;
+
+	// 부모 재질별로 쉬고 있는 인스턴스
+	TMap<TWeakObjectPtr<UMaterialInterface>, TArray<TStrongObjectPtr<UMaterialInstanceDynamic>>> FreeInstances;
+
+	int FreeCount = 0;
+
+	int64 AcquireCount = 0;
+
+	int64 SharedCount = 0;
+
+	int64 ReusedCount = 0;
+
+	int64 CreatedCount = 0;
+
+	double CreateSeconds = 0.0;
+};
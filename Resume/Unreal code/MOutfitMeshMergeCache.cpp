@@ -0,0 +1,312 @@
+/***********************************************************************************
+ *                                                                                 *
+ * Copyright. (C) 2023 Mobirix.                                                    *
+ * Website: https://mobirix.com													   *
+ *                                                                                 *
+ ***********************************************************************************/
+
+
+#include "Outfit/MOutfitMeshMergeCache.h"
+
+#include "Engine/AssetManager.h"
+#include "Engine/SkeletalMesh.h"
+#include "HAL/IConsoleManager.h"
+#include "Outfit/FMHeroOutfit.h"
+#include "SkeletalMeshMerge.h"
+
+DEFINE_LOG_CATEGORY_STATIC(LogMOutfitMeshMerge, Log, All);
+
+namespace MOutfitMeshMerge
+{
+	int32 Enabled = 1;
+	FAutoConsoleVariableRef CVarEnabled(TEXT("MOutfit.MergedMesh"), Enabled, TEXT("Merge hero outfit parts into one skeletal mesh shared across actors."));
+
+	int32 BudgetMB = 64;
+	FAutoConsoleVariableRef CVarBudgetMB(TEXT("MOutfit.MergedMeshBudgetMB"), BudgetMB, TEXT("Memory budget for merged outfit meshes no actor is using."));
+
+	int32 MergesPerFrame = 1;
+	FAutoConsoleVariableRef CVarMergesPerFrame(TEXT("MOutfit.MergedMeshPerFrame"), MergesPerFrame, TEXT("Number of outfit mesh merges done per frame."));
+
+	FAutoConsoleCommand DumpCommand(
+		TEXT("MOutfit.DumpMergedMeshes"),
+		TEXT("Dump merged outfit mesh cache usage."),
+		FConsoleCommandDelegate::CreateLambda([ ] ()
+		{
+			FMOutfitMeshMergeCache::Get().Dump();
+		}));
+}
+
+FMOutfitMeshKey FMOutfitMeshKey::FromOutfit(const FMHeroOutfitData& InOutfit)
+{
+	FMOutfitMeshKey Key;
+	Key.BundleID = InOutfit.BundleID;
+	Key.Parts.Append(InOutfit.Parts);
+
+	// 무기는 따로 붙여 그리고 자주 바뀌므로 합치지도, 키에 넣지도 않는다.
+	const int WeaponIndex = static_cast<int>(EMUnitPartType::Weapon);
+	if (Key.Parts.IsValidIndex(WeaponIndex))
+	{
+		Key.Parts[WeaponIndex] = 0;
+	}
+
+	for (const auto& Material : InOutfit.Materials)
+	{
+		Key.MaterialsHash = HashCombine(Key.MaterialsHash, GetTypeHash(Material));
+	}
+
+	return Key;
+}
+
+FMOnResolveOutfitPartMesh FMOutfitMeshMergeCache::OnResolvePartMesh;
+
+FMOutfitMeshMergeCache& FMOutfitMeshMergeCache::Get()
+{
+	static FMOutfitMeshMergeCache Cache;
+	return Cache;
+}
+
+USkeletalMesh* FMOutfitMeshMergeCache::Acquire(const FMOutfitMeshKey& InKey, FMOnOutfitMeshMerged&& InOnMerged)
+{
+	if (MOutfitMeshMerge::Enabled == 0 || OnResolvePartMesh.IsBound() == false)
+	{
+		return nullptr;
+	}
+
+	if (FEntry* Entry = Entries.Find(InKey))
+	{
+		Entry->RefCount++;
+		Entry->LastUsed = ++UseSerial;
+
+		if (Entry->State == EState::Ready)
+		{
+			HitCount++;
+			return Entry->Mesh.Get();
+		}
+
+		if (Entry->State != EState::Failed && InOnMerged.IsBound())
+		{
+			Entry->Waiters.Emplace(MoveTemp(InOnMerged));
+		}
+
+		return nullptr;
+	}
+
+	MissCount++;
+
+	FEntry& Entry = Entries.Add(InKey);
+	Entry.RefCount = 1;
+	Entry.LastUsed = ++UseSerial;
+
+	for (const int MeshID : InKey.Parts)
+	{
+		if (MeshID > 0)
+		{
+			const FSoftObjectPath Path = OnResolvePartMesh.Execute(MeshID);
+			if (Path.IsNull() == false)
+			{
+				Entry.PartPaths.Emplace(Path);
+			}
+		}
+	}
+
+	// 합칠 파츠가 하나뿐이면 그대로 쓰는 편이 낫다.
+	if (Entry.PartPaths.Num() < 2)
+	{
+		Entry.State = EState::Failed;
+		return nullptr;
+	}
+
+	if (InOnMerged.IsBound())
+	{
+		Entry.Waiters.Emplace(MoveTemp(InOnMerged));
+	}
+
+	const FMOutfitMeshKey Key = InKey;
+	Entry.LoadHandle = UAssetManager::GetStreamableManager().RequestAsyncLoad(Entry.PartPaths, FStreamableDelegate::CreateLambda([ Key ] ()
+	{
+		FMOutfitMeshMergeCache::Get().OnPartsLoaded(Key);
+	}), FStreamableManager::DefaultAsyncLoadPriority);
+
+	return nullptr;
+}
+
+void FMOutfitMeshMergeCache::Release(const FMOutfitMeshKey& InKey)
+{
+	FEntry* Entry = Entries.Find(InKey);
+	if (Entry == nullptr)
+	{
+		return;
+	}
+
+	Entry->RefCount = FMath::Max(Entry->RefCount - 1, 0);
+	if (Entry->RefCount > 0)
+	{
+		return;
+	}
+
+	Entry->Waiters.Reset();
+
+	// 아직 만들지 않은 메시는 더 기다릴 이유가 없다.
+	if (Entry->State == EState::Loading || Entry->State == EState::Queued || Entry->State == EState::Failed)
+	{
+		if (Entry->LoadHandle.IsValid())
+		{
+			Entry->LoadHandle->CancelHandle();
+		}
+
+		MergeQueue.Remove(InKey);
+		Entries.Remove(InKey);
+		return;
+	}
+
+	Trim();
+}
+
+void FMOutfitMeshMergeCache::OnPartsLoaded(const FMOutfitMeshKey& InKey)
+{
+	FEntry* Entry = Entries.Find(InKey);
+	if (Entry == nullptr || Entry->State != EState::Loading)
+	{
+		return;
+	}
+
+	Entry->State = EState::Queued;
+	MergeQueue.Emplace(InKey);
+
+	if (TickHandle.IsValid() == false)
+	{
+		TickHandle = FTSTicker::GetCoreTicker().AddTicker(FTickerDelegate::CreateRaw(this, &FMOutfitMeshMergeCache::Tick));
+	}
+}
+
+bool FMOutfitMeshMergeCache::Tick(float InDeltaTime)
+{
+	TRACE_CPUPROFILER_EVENT_SCOPE(MOutfitMeshMerge_Tick);
+
+	int Merged = 0;
+	while (MergeQueue.Num() > 0 && Merged < FMath::Max(MOutfitMeshMerge::MergesPerFrame, 1))
+	{
+		const FMOutfitMeshKey Key = MergeQueue[0];
+		MergeQueue.RemoveAt(0, 1, false);
+
+		FEntry* Entry = Entries.Find(Key);
+		if (Entry == nullptr || Entry->State != EState::Queued)
+		{
+			continue;
+		}
+
+		Merged++;
+
+		if (Merge(*Entry) == false)
+		{
+			Entry->State = EState::Failed;
+			Entry->Waiters.Reset();
+			Entry->LoadHandle.Reset();
+			continue;
+		}
+
+		Entry->State = EState::Ready;
+		Entry->LoadHandle.Reset();
+		TotalBytes += Entry->Bytes;
+
+		// 대기자가 Release/Acquire를 다시 불러도 안전하도록 먼저 꺼낸다.
+		TArray<FMOnOutfitMeshMerged> Waiters = MoveTemp(Entry->Waiters);
+		USkeletalMesh* Mesh = Entry->Mesh.Get();
+		for (FMOnOutfitMeshMerged& Waiter : Waiters)
+		{
+			Waiter.ExecuteIfBound(Mesh);
+		}
+	}
+
+	Trim();
+
+	if (MergeQueue.Num() <= 0)
+	{
+		TickHandle.Reset();
+		return false;
+	}
+
+	return true;
+}
+
+bool FMOutfitMeshMergeCache::Merge(FEntry& InEntry)
+{
+	TRACE_CPUPROFILER_EVENT_SCOPE(MOutfitMeshMerge_Merge);
+
+	TArray<USkeletalMesh*> SourceMeshes;
+	for (const FSoftObjectPath& Path : InEntry.PartPaths)
+	{
+		USkeletalMesh* SourceMesh = Cast<USkeletalMesh>(Path.ResolveObject());
+		if (SourceMesh == nullptr)
+		{
+			return false;
+		}
+
+		SourceMeshes.Emplace(SourceMesh);
+	}
+
+	USkeletalMesh* MergedMesh = NewObject<USkeletalMesh>(GetTransientPackage(), NAME_None, RF_Transient);
+	MergedMesh->SetSkeleton(SourceMeshes[0]->GetSkeleton());
+
+	FSkeletalMeshMerge Merger(MergedMesh, SourceMeshes, TArray<FSkelMeshMergeSectionMapping>(), 0);
+	if (Merger.DoMerge() == false)
+	{
+		UE_LOG(LogMOutfitMeshMerge, Warning, TEXT("Merge failed. Parts=%d"), SourceMeshes.Num());
+		return false;
+	}
+
+	InEntry.Mesh.Reset(MergedMesh);
+	InEntry.Bytes = MergedMesh->GetResourceSizeBytes(EResourceSizeMode::EstimatedTotal);
+
+	return true;
+}
+
+void FMOutfitMeshMergeCache::Trim()
+{
+	const SIZE_T Budget = static_cast<SIZE_T>(FMath::Max(MOutfitMeshMerge::BudgetMB, 0)) * 1024 * 1024;
+
+	while (TotalBytes > Budget)
+	{
+		const FMOutfitMeshKey* Oldest = nullptr;
+		uint64 OldestUsed = MAX_uint64;
+
+		for (const TPair<FMOutfitMeshKey, FEntry>& Pair : Entries)
+		{
+			if (Pair.Value.State == EState::Ready && Pair.Value.RefCount <= 0 && Pair.Value.LastUsed < OldestUsed)
+			{
+				Oldest = &Pair.Key;
+				OldestUsed = Pair.Value.LastUsed;
+			}
+		}
+
+		// 남은 메시는 모두 쓰는 중이다.
+		if (Oldest == nullptr)
+		{
+			break;
+		}
+
+		const FMOutfitMeshKey Key = *Oldest;
+		TotalBytes -= FMath::Min(TotalBytes, Entries[Key].Bytes);
+		Entries.Remove(Key);
+		EvictCount++;
+	}
+}
+
+void FMOutfitMeshMergeCache::Dump() const
+{
+	int Ready = 0;
+	int Pending = 0;
+	int Failed = 0;
+	int InUse = 0;
+
+	for (const TPair<FMOutfitMeshKey, FEntry>& Pair : Entries)
+	{
+		Ready += Pair.Value.State == EState::Ready ? 1 : 0;
+		Pending += (Pair.Value.State == EState::Loading || Pair.Value.State == EState::Queued) ? 1 : 0;
+		Failed += Pair.Value.State == EState::Failed ? 1 : 0;
+		InUse += Pair.Value.RefCount > 0 ? 1 : 0;
+	}
+
+	UE_LOG(LogMOutfitMeshMerge, Display, TEXT("Merged outfit meshes: Ready=%d Pending=%d Failed=%d InUse=%d Bytes=%llu Budget=%dMB"), Ready, Pending, Failed, InUse, static_cast<uint64>(TotalBytes), MOutfitMeshMerge::BudgetMB);
+	UE_LOG(LogMOutfitMeshMerge, Display, TEXT("Hit=%lld Miss=%lld Evict=%lld"), HitCount, MissCount, EvictCount);
+}
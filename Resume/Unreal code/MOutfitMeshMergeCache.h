@@ -0,0 +1,121 @@
+/***********************************************************************************
+ *                                                                                 *
+ * Copyright. (C) 2023 Mobirix.                                                    *
+ * Website: https://mobirix.com													   *
+ *                                                                                 *
+ ***********************************************************************************/
+
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Containers/Ticker.h"
+#include "Engine/StreamableManager.h"
+#include "UObject/StrongObjectPtr.h"
+
+class USkeletalMesh;
+struct FMHeroOutfitData;
+
+// 합친 메시를 구분하는 키. 같은 번들에 같은 파츠와 재질이면 액터끼리 같은 메시를 쓴다.
+// 무기 파츠는 0으로 두어 무기만 다른 액터도 같은 메시를 쓴다.
+struct MRPG_API FMOutfitMeshKey
+{
+	int BundleID = 0;
+
+	TArray<int, TInlineAllocator<8>> Parts;
+
+	uint32 MaterialsHash = 0;
+
+	static FMOutfitMeshKey FromOutfit(const FMHeroOutfitData& InOutfit);
+
+	bool operator==(const FMOutfitMeshKey& InOther) const
+	{
+		return BundleID == InOther.BundleID && MaterialsHash == InOther.MaterialsHash && Parts == InOther.Parts;
+	}
+
+	friend uint32 GetTypeHash(const FMOutfitMeshKey& InKey)
+	{
+		uint32 Hash = HashCombine(GetTypeHash(InKey.BundleID), InKey.MaterialsHash);
+		for (const int Part : InKey.Parts)
+		{
+			Hash = HashCombine(Hash, GetTypeHash(Part));
+		}
+		return Hash;
+	}
+};
+
+// 파츠 메시 ID의 어셋 경로를 찾는다. 어셋 테이블을 가진 쪽에서 바인드한다.
+DECLARE_DELEGATE_RetVal_OneParam(FSoftObjectPath, FMOnResolveOutfitPartMesh, const int /*InMeshID*/);
+
+DECLARE_DELEGATE_OneParam(FMOnOutfitMeshMerged, USkeletalMesh* /*InMergedMesh*/);
+
+// 의상 파츠를 하나로 합친 스켈레탈 메시 캐시.
+// 파츠 어셋은 비동기로 읽고, 합치기는 게임 스레드에서 프레임당 정해진 수만 처리한다.
+// 준비되기 전에는 Acquire가 nullptr를 돌려주므로 호출한 쪽은 파츠별 컴포넌트로 그린다.
+// 아무도 쓰지 않는 메시는 예산(MOutfit.MergedMeshBudgetMB)을 넘으면 오래된 것부터 버린다.
+class MRPG_API FMOutfitMeshMergeCache
+{
+public:
+	static FMOnResolveOutfitPartMesh OnResolvePartMesh;
+
+	static FMOutfitMeshMergeCache& Get();
+
+	// Acquire한 키는 쓰지 않게 되면 반드시 Release한다. 준비되면 InOnMerged가 불린다.
+	USkeletalMesh* Acquire(const FMOutfitMeshKey& InKey, FMOnOutfitMeshMerged&& InOnMerged);
+
+	void Release(const FMOutfitMeshKey& InKey);
+
+	void Trim();
+
+	void Dump() const;
+
+private:
+	enum class EState : uint8
+	{
+		Loading,
+		Queued,
+		Ready,
+		Failed,
+	};
+
+	struct FEntry
+	{
+		EState State = EState::Loading;
+
+		int RefCount = 0;
+
+		uint64 LastUsed = 0;
+
+		SIZE_T Bytes = 0;
+
+		TArray<FSoftObjectPath> PartPaths;
+
+		TSharedPtr<FStreamableHandle> LoadHandle;
+
+		TStrongObjectPtr<USkeletalMesh> Mesh;
+
+		TArray<FMOnOutfitMeshMerged> Waiters;
+	};
+
+	void OnPartsLoaded(const FMOutfitMeshKey& InKey);
+
+	bool Tick(float InDeltaTime);
+
+	bool Merge(FEntry& InEntry);
+
+	TMap<FMOutfitMeshKey, FEntry> Entries;
+
+	TArray<FMOutfitMeshKey> MergeQueue;
+
+	FTSTicker::FDelegateHandle TickHandle;
+
+	SIZE_T TotalBytes = 0;
+
+	uint64 UseSerial = 0;
+
+	int64 HitCount = 0;
+
+	int64 MissCount = 0;
+
+	int64 EvictCount = 0;
+};
@@ -0,0 +1,281 @@
+/***********************************************************************************
+ *                                                                                 *
+ * Copyright. (C) 2023 Mobirix.                                                    *
+ * Website: https://mobirix.com													   *
+ *                                                                                 *
+ ***********************************************************************************/
+
+
+#include "Outfit/MOutfitPartRules.h"
+
+#include "Outfit/FMHeroOutfit.h"
+#include "Outfit/MOutfitDataTables.h"
+
+namespace MOutfitPartRules
+{
+	using ESource = EMOutfitPartSource;
+	using ECondition = EMOutfitPartCondition;
+
+	constexpr ECondition UseCustomHair = ECondition::HideHelmet | ECondition::OutfitHeadgearEmpty;
+
+	// 파츠별 규칙. 단계는 순서대로 적용되어 뒤의 단계가 앞의 값을 덮는다.
+	constexpr FMOutfitPartRule Rules[] =
+	{
+		{ EMUnitPartType::Weapon,	2, { { ESource::Outfit }, { ESource::WeaponCostume } } },
+		{ EMUnitPartType::Body,		1, { { ESource::Outfit } } },
+		{ EMUnitPartType::Helmet,	2, { { ESource::Outfit }, { ESource::Empty, ECondition::HideHelmet } } },
+		{ EMUnitPartType::Head,		2, { { ESource::Custom }, { ESource::Preset, ECondition::CustomHeadEmpty } } },
+		{ EMUnitPartType::Hair,		4, { { ESource::Outfit }, { ESource::Empty, UseCustomHair }, { ESource::Custom, UseCustomHair }, { ESource::Preset, ECondition::CustomHeadEmpty } } },
+	};
+
+	// 규칙 엔진이 고른 파츠와 이펙트, 재질을 의상에 옮긴다.
+	void ApplyResolvedOutfit(FMHeroOutfitData& InOutfit, const FMOutfitPartBatch& InBatch, const int InIndex, const FMOutfitDataTables& InTables)
+	{
+		const FMPawnData* OutfitData = InOutfit.OutfitData;
+
+		for (int i = 0; i < InOutfit.Parts.Num(); i++)
+		{
+			InOutfit.Parts[i] = InBatch.GetPart(InIndex, static_cast<EMUnitPartType>(i));
+		}
+
+		for (FString& Effect : InOutfit.PartEffects)
+		{
+			Effect = TEXT("");
+		}
+
+		InOutfit.BundleID = OutfitData->UnitID;
+		InOutfit.PartEffects[static_cast<int>(EMUnitPartType::Body)] = OutfitData->EffectSocketID;
+
+		const FMHeroCustomizingInfo& Customizing = OutfitData->Gender == EMGender::Female ? InOutfit.FemaleCustomizing : InOutfit.MaleCustomizing;
+		InOutfit.Materials = Customizing.CustomMaterials;
+
+		if (InOutfit.WeaponCostumeTID > 0)
+		{
+			if (const FMOutfitItemRecord* Weapon = InTables.FindItem(InOutfit.WeaponCostumeTID))
+			{
+				InOutfit.PartEffects[static_cast<int>(EMUnitPartType::Weapon)] = OutfitData->Gender == EMGender::Female ? Weapon->FemaleEffectSocketID : Weapon->MaleEffectSocketID;
+			}
+		}
+
+		if (InOutfit.TransformTID > 0)
+		{
+			if (const FMOutfitTransformRecord* TransformData = InTables.FindTransform(InOutfit.TransformTID))
+			{
+				for (int i = 0; i < TransformData->UnitIDs.Num(); i++)
+				{
+					if (TransformData->UnitIDs[i] != OutfitData->UnitID)
+					{
+						continue;
+					}
+
+					InOutfit.PartEffects[static_cast<int>(EMUnitPartType::Weapon)] = TransformData->EquipmentEffectSocketIDs.Num() > i ? TransformData->EquipmentEffectSocketIDs[i] : TEXT("");
+				}
+			}
+		}
+
+		InOutfit.IsOutfitChanged = true;
+	}
+}
+
+TConstArrayView<FMOutfitPartRule> FMOutfitPartBatch::GetRules()
+{
+	return MOutfitPartRules::Rules;
+}
+
+void FMOutfitPartBatch::Reset(const int InCount)
+{
+	Count = FMath::Max(InCount, 0);
+
+	Values.Reset();
+	Values.SetNumZeroed(SourceCount * PartCount * Count);
+
+	ValidMasks.Reset();
+	ValidMasks.SetNumZeroed(SourceCount * PartCount * Count);
+
+	Conditions.Reset();
+	Conditions.SetNumZeroed(Count);
+
+	Results.Reset();
+	Results.SetNumZeroed(PartCount * Count);
+}
+
+void FMOutfitPartBatch::SetSource(const int InOutfit, const EMOutfitPartSource InSource, const EMUnitPartType InPart, const int InMeshID)
+{
+	if (InSource >= EMOutfitPartSource::Max || InPart >= EMUnitPartType::Max || InOutfit < 0 || InOutfit >= Count)
+	{
+		return;
+	}
+
+	const int Offset = GetSourceOffset(InSource, InPart) + InOutfit;
+	Values[Offset] = InMeshID;
+	ValidMasks[Offset] = -1;
+}
+
+void FMOutfitPartBatch::AddCondition(const int InOutfit, const EMOutfitPartCondition InCondition)
+{
+	if (Conditions.IsValidIndex(InOutfit))
+	{
+		Conditions[InOutfit] |= static_cast<uint32>(InCondition);
+	}
+}
+
+void FMOutfitPartBatch::Resolve()
+{
+	TRACE_CPUPROFILER_EVENT_SCOPE(MOutfitPartBatch_Resolve);
+
+	const uint32* ConditionData = Conditions.GetData();
+
+	for (const FMOutfitPartRule& Rule : MOutfitPartRules::Rules)
+	{
+		int32* Result = Results.GetData() + static_cast<int>(Rule.Part) * Count;
+
+		for (int Step = 0; Step < Rule.StepCount; Step++)
+		{
+			const FMOutfitPartRuleStep& RuleStep = Rule.Steps[Step];
+			const uint32 AnyOf = static_cast<uint32>(RuleStep.AnyOf);
+			const uint32 Always = AnyOf == 0 ? 1 : 0;
+
+			if (RuleStep.Source == EMOutfitPartSource::Empty)
+			{
+				for (int i = 0; i < Count; i++)
+				{
+					const int32 Take = -static_cast<int32>(Always | ((ConditionData[i] & AnyOf) != 0));
+					Result[i] &= ~Take;
+				}
+				continue;
+			}
+
+			const int Offset = GetSourceOffset(RuleStep.Source, Rule.Part);
+			const int32* Value = Values.GetData() + Offset;
+			const int32* Valid = ValidMasks.GetData() + Offset;
+
+			for (int i = 0; i < Count; i++)
+			{
+				const int32 Take = Valid[i] & -static_cast<int32>(Always | ((ConditionData[i] & AnyOf) != 0));
+				Result[i] = (Value[i] & Take) | (Result[i] & ~Take);
+			}
+		}
+	}
+}
+
+int FMOutfitPartBatch::GetPart(const int InOutfit, const EMUnitPartType InPart) const
+{
+	if (InPart >= EMUnitPartType::Max || InOutfit < 0 || InOutfit >= Count)
+	{
+		return 0;
+	}
+
+	return Results[static_cast<int>(InPart) * Count + InOutfit];
+}
+
+void FMOutfitPartBatch::Gather(const FMHeroOutfitData& InOutfit, FMOutfitPartBatch& InOutBatch, const int InIndex)
+{
+	const FMPawnData* OutfitData = InOutfit.OutfitData;
+	if (OutfitData == nullptr)
+	{
+		return;
+	}
+
+	FMOutfitDataTables& Tables = FMOutfitDataTables::Get();
+
+	InOutBatch.SetSource(InIndex, EMOutfitPartSource::Outfit, EMUnitPartType::Weapon, OutfitData->WeaponMeshID);
+	InOutBatch.SetSource(InIndex, EMOutfitPartSource::Outfit, EMUnitPartType::Body, OutfitData->BodyMeshID);
+	InOutBatch.SetSource(InIndex, EMOutfitPartSource::Outfit, EMUnitPartType::Helmet, OutfitData->HelmetMeshID);
+	InOutBatch.SetSource(InIndex, EMOutfitPartSource::Outfit, EMUnitPartType::Hair, OutfitData->HairMeshID);
+
+	const bool bOutfitHeadgearEmpty = OutfitData->HelmetMeshID == 0 && OutfitData->HairMeshID == 0;
+	if (InOutfit.bHideHelmet)
+	{
+		InOutBatch.AddCondition(InIndex, EMOutfitPartCondition::HideHelmet);
+	}
+
+	if (bOutfitHeadgearEmpty)
+	{
+		InOutBatch.AddCondition(InIndex, EMOutfitPartCondition::OutfitHeadgearEmpty);
+	}
+
+	const FMHeroCustomizingInfo& Customizing = OutfitData->Gender == EMGender::Female ? InOutfit.FemaleCustomizing : InOutfit.MaleCustomizing;
+
+	int CustomHeadMesh = 0;
+	const int HeadPartID = Customizing.CustomParts[static_cast<int>(EMUnitPartType::Head)];
+	if (HeadPartID > 0)
+	{
+		if (const int* Mesh = Tables.FindCustomizingAssetMesh(HeadPartID))
+		{
+			InOutBatch.SetSource(InIndex, EMOutfitPartSource::Custom, EMUnitPartType::Head, *Mesh);
+			CustomHeadMesh = *Mesh;
+		}
+	}
+
+	// 커스터마이징 머리는 쓰일 때만 조회한다.
+	if (InOutfit.bHideHelmet || bOutfitHeadgearEmpty)
+	{
+		const int HairPartID = Customizing.CustomParts[static_cast<int>(EMUnitPartType::Hair)];
+		if (HairPartID > 0)
+		{
+			if (const int* Mesh = Tables.FindCustomizingAssetMesh(HairPartID))
+			{
+				InOutBatch.SetSource(InIndex, EMOutfitPartSource::Custom, EMUnitPartType::Hair, *Mesh);
+			}
+		}
+	}
+
+	// 얼굴 어셋을 찾지 못했을 경우에만 기본 프리셋을 조회한다.
+	if (CustomHeadMesh == 0)
+	{
+		InOutBatch.AddCondition(InIndex, EMOutfitPartCondition::CustomHeadEmpty);
+
+		if (const FMOutfitPresetRecord* Preset = Tables.FindReferencePreset(*OutfitData))
+		{
+			if (const int* Mesh = Tables.FindCustomizingAssetMesh(Preset->FaceMesh))
+			{
+				InOutBatch.SetSource(InIndex, EMOutfitPartSource::Preset, EMUnitPartType::Head, *Mesh);
+			}
+
+			if (const int* Mesh = Tables.FindCustomizingAssetMesh(Preset->HairMesh))
+			{
+				InOutBatch.SetSource(InIndex, EMOutfitPartSource::Preset, EMUnitPartType::Hair, *Mesh);
+			}
+		}
+	}
+
+	if (InOutfit.WeaponCostumeTID > 0)
+	{
+		if (const FMOutfitItemRecord* Weapon = Tables.FindItem(InOutfit.WeaponCostumeTID))
+		{
+			InOutBatch.SetSource(InIndex, EMOutfitPartSource::WeaponCostume, EMUnitPartType::Weapon, Weapon->WeaponMeshID);
+		}
+	}
+}
+
+void FMOutfitPartBatch::UpdateOutfits(TArrayView<FMHeroOutfitData* const> InOutfits)
+{
+	TRACE_CPUPROFILER_EVENT_SCOPE(MOutfitPartBatch_UpdateOutfits);
+
+	TArray<FMHeroOutfitData*, TInlineAllocator<16>> Outfits;
+	for (FMHeroOutfitData* Outfit : InOutfits)
+	{
+		if (Outfit && Outfit->OutfitData)
+		{
+			Outfits.Add(Outfit);
+		}
+	}
+
+	FMOutfitDataTables& Tables = FMOutfitDataTables::Get();
+	Tables.RefreshIfStale();
+
+	FMOutfitPartBatch Batch;
+	Batch.Reset(Outfits.Num());
+
+	for (int i = 0; i < Outfits.Num(); i++)
+	{
+		Gather(*Outfits[i], Batch, i);
+	}
+
+	Batch.Resolve();
+
+	for (int i = 0; i < Outfits.Num(); i++)
+	{
+		MOutfitPartRules::ApplyResolvedOutfit(*Outfits[i], Batch, i, Tables);
+	}
+}
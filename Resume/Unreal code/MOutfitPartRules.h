@@ -0,0 +1,104 @@
+/***********************************************************************************
+ *                                                                                 *
+ * Copyright. (C) 2023 Mobirix.                                                    *
+ * Website: https://mobirix.com													   *
+ *                                                                                 *
+ ***********************************************************************************/
+
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Data/Base/MdataStruct.h"
+
+struct FMHeroOutfitData;
+
+// 파츠 메시 ID를 가져올 수 있는 출처
+enum class EMOutfitPartSource : uint8
+{
+	Outfit,			// 의상 폰 데이터
+	Custom,			// 커스터마이징 어셋
+	Preset,			// 기준 프리셋 어셋
+	WeaponCostume,	// 무기 코스튬 아이템
+	Max,
+
+	Empty = Max,	// 비운다(0)
+};
+
+// 의상 하나에 대해 미리 구해두는 조건
+enum class EMOutfitPartCondition : uint32
+{
+	None				= 0,
+	HideHelmet			= 1 << 0,
+	OutfitHeadgearEmpty	= 1 << 1,	// 의상에 투구와 머리 메시가 모두 없다
+	CustomHeadEmpty		= 1 << 2,	// 커스터마이징 얼굴을 찾지 못했다
+};
+ENUM_CLASS_FLAGS(EMOutfitPartCondition);
+
+// 규칙 한 단계. AnyOf 조건 중 하나라도 맞고(None이면 항상) 출처 값이 있으면 파츠 값을 덮어쓴다.
+struct FMOutfitPartRuleStep
+{
+	EMOutfitPartSource Source = EMOutfitPartSource::Empty;
+
+	EMOutfitPartCondition AnyOf = EMOutfitPartCondition::None;
+};
+
+struct FMOutfitPartRule
+{
+	static constexpr int MaxSteps = 4;
+
+	EMUnitPartType Part = EMUnitPartType::Max;
+
+	int StepCount = 0;
+
+	FMOutfitPartRuleStep Steps[MaxSteps];
+};
+
+// 여러 의상의 파츠를 한번에 고른다. 출처 값과 조건은 의상별로 나란히 놓이고,
+// 규칙 단계마다 모든 의상에 분기 없는 선택을 적용한다.
+class MRPG_API FMOutfitPartBatch
+{
+public:
+	static constexpr int PartCount = static_cast<int>(EMUnitPartType::Max);
+
+	static constexpr int SourceCount = static_cast<int>(EMOutfitPartSource::Max);
+
+	static TConstArrayView<FMOutfitPartRule> GetRules();
+
+	void Reset(const int InCount);
+
+	int Num() const { return Count; }
+
+	void SetSource(const int InOutfit, const EMOutfitPartSource InSource, const EMUnitPartType InPart, const int InMeshID);
+
+	void AddCondition(const int InOutfit, const EMOutfitPartCondition InCondition);
+
+	void Resolve();
+
+	int GetPart(const int InOutfit, const EMUnitPartType InPart) const;
+
+	// 의상 데이터에서 출처 값과 조건을 모은다. 필요한 조건일 때만 FMOutfitDataTables를 조회하므로
+	// UpdateOutfits처럼 조회 테이블을 갱신한 뒤에 부른다.
+	static void Gather(const FMHeroOutfitData& InOutfit, FMOutfitPartBatch& InOutBatch, const int InIndex);
+
+	// 여러 의상을 한번에 다시 계산한다.
+	static void UpdateOutfits(TArrayView<FMHeroOutfitData* const> InOutfits);
+
+private:
+	int GetSourceOffset(const EMOutfitPartSource InSource, const EMUnitPartType InPart) const
+	{
+		return (static_cast<int>(InSource) * PartCount + static_cast<int>(InPart)) * Count;
+	}
+
+	int Count = 0;
+
+	// 한 의상이면 힙 할당 없이 처리한다.
+	TArray<int32, TInlineAllocator<SourceCount * PartCount>> Values;
+
+	// 값이 있으면 -1, 없으면 0
+	TArray<int32, TInlineAllocator<SourceCount * PartCount>> ValidMasks;
+
+	TArray<uint32, TInlineAllocator<1>> Conditions;
+
+	TArray<int32, TInlineAllocator<PartCount>> Results;
+};
@@ -0,0 +1,180 @@
+/***********************************************************************************
+ *                                                                                 *
+ * Copyright. (C) 2023 Mobirix.                                                    *
+ * Website: https://mobirix.com													   *
+ *                                                                                 *
+ ***********************************************************************************/
+
+
+#include "Misc/AutomationTest.h"
+#include "Outfit/MOutfitPartRules.h"
+
+#if WITH_DEV_AUTOMATION_TESTS
+
+namespace MOutfitPartRulesTests
+{
+	// 데이터 테이블 대신 조회가 끝난 메시 ID로 의상을 적는다. 0은 값이 없음
+	struct FFixture
+	{
+		const TCHAR* Name = TEXT("");
+
+		int OutfitWeapon = 0;
+		int OutfitBody = 0;
+		int OutfitHelmet = 0;
+		int OutfitHair = 0;
+
+		int CustomHead = 0;
+		int CustomHair = 0;
+
+		int PresetFace = 0;
+		int PresetHair = 0;
+
+		int WeaponCostume = 0;
+
+		bool bHideHelmet = false;
+
+		// Weapon, Body, Helmet, Head, Hair
+		int Expected[5] = {};
+	};
+
+	constexpr EMUnitPartType CheckedParts[] = { EMUnitPartType::Weapon, EMUnitPartType::Body, EMUnitPartType::Helmet, EMUnitPartType::Head, EMUnitPartType::Hair };
+
+	const FFixture Fixtures[] =
+	{
+		{ TEXT("Outfit parts"),						101, 102, 103, 104, 201, 202, 301, 302, 0,   false, { 101, 102, 103, 201, 104 } },
+		{ TEXT("Hide helmet"),						101, 102, 103, 104, 201, 202, 301, 302, 0,   true,  { 101, 102, 0,   201, 202 } },
+		{ TEXT("Hide helmet without custom hair"),	101, 102, 103, 104, 201, 0,   301, 302, 0,   true,  { 101, 102, 0,   201, 0   } },
+		{ TEXT("Empty headgear"),					101, 102, 0,   0,   201, 202, 301, 302, 0,   false, { 101, 102, 0,   201, 202 } },
+		{ TEXT("Custom head missing"),				101, 102, 103, 104, 0,   202, 301, 302, 0,   false, { 101, 102, 103, 301, 302 } },
+		{ TEXT("Custom head missing, no preset"),	101, 102, 103, 104, 0,   202, 0,   0,   0,   false, { 101, 102, 103, 0,   104 } },
+		{ TEXT("Weapon costume"),					101, 102, 103, 104, 201, 202, 301, 302, 401, false, { 401, 102, 103, 201, 104 } },
+		{ TEXT("Hide helmet, preset, costume"),		101, 102, 103, 104, 0,   202, 301, 302, 401, true,  { 401, 102, 0,   301, 302 } },
+	};
+
+	// FMOutfitPartBatch::Gather와 같은 규칙으로 출처 값과 조건을 넣는다.
+	void Gather(const FFixture& InFixture, FMOutfitPartBatch& InOutBatch, const int InIndex)
+	{
+		InOutBatch.SetSource(InIndex, EMOutfitPartSource::Outfit, EMUnitPartType::Weapon, InFixture.OutfitWeapon);
+		InOutBatch.SetSource(InIndex, EMOutfitPartSource::Outfit, EMUnitPartType::Body, InFixture.OutfitBody);
+		InOutBatch.SetSource(InIndex, EMOutfitPartSource::Outfit, EMUnitPartType::Helmet, InFixture.OutfitHelmet);
+		InOutBatch.SetSource(InIndex, EMOutfitPartSource::Outfit, EMUnitPartType::Hair, InFixture.OutfitHair);
+
+		const bool bOutfitHeadgearEmpty = InFixture.OutfitHelmet == 0 && InFixture.OutfitHair == 0;
+		if (InFixture.bHideHelmet)
+		{
+			InOutBatch.AddCondition(InIndex, EMOutfitPartCondition::HideHelmet);
+		}
+
+		if (bOutfitHeadgearEmpty)
+		{
+			InOutBatch.AddCondition(InIndex, EMOutfitPartCondition::OutfitHeadgearEmpty);
+		}
+
+		if (InFixture.CustomHead > 0)
+		{
+			InOutBatch.SetSource(InIndex, EMOutfitPartSource::Custom, EMUnitPartType::Head, InFixture.CustomHead);
+		}
+
+		if ((InFixture.bHideHelmet || bOutfitHeadgearEmpty) && InFixture.CustomHair > 0)
+		{
+			InOutBatch.SetSource(InIndex, EMOutfitPartSource::Custom, EMUnitPartType::Hair, InFixture.CustomHair);
+		}
+
+		if (InFixture.CustomHead == 0)
+		{
+			InOutBatch.AddCondition(InIndex, EMOutfitPartCondition::CustomHeadEmpty);
+
+			if (InFixture.PresetFace > 0)
+			{
+				InOutBatch.SetSource(InIndex, EMOutfitPartSource::Preset, EMUnitPartType::Head, InFixture.PresetFace);
+			}
+
+			if (InFixture.PresetHair > 0)
+			{
+				InOutBatch.SetSource(InIndex, EMOutfitPartSource::Preset, EMUnitPartType::Hair, InFixture.PresetHair);
+			}
+		}
+
+		if (InFixture.WeaponCostume > 0)
+		{
+			InOutBatch.SetSource(InIndex, EMOutfitPartSource::WeaponCostume, EMUnitPartType::Weapon, InFixture.WeaponCostume);
+		}
+	}
+
+	// 규칙 테이블 도입 전의 분기 로직
+	void ResolveLegacy(const FFixture& InFixture, TArray<int>& OutParts)
+	{
+		OutParts.Reset();
+		OutParts.SetNumZeroed(static_cast<int>(EMUnitPartType::Max));
+
+		OutParts[static_cast<int>(EMUnitPartType::Weapon)] = InFixture.OutfitWeapon;
+		OutParts[static_cast<int>(EMUnitPartType::Body)] = InFixture.OutfitBody;
+		OutParts[static_cast<int>(EMUnitPartType::Helmet)] = InFixture.bHideHelmet ? 0 : InFixture.OutfitHelmet;
+		OutParts[static_cast<int>(EMUnitPartType::Head)] = InFixture.CustomHead;
+
+		if (InFixture.bHideHelmet || (InFixture.OutfitHelmet == 0 && InFixture.OutfitHair == 0))
+		{
+			OutParts[static_cast<int>(EMUnitPartType::Hair)] = InFixture.CustomHair;
+		}
+		else
+		{
+			OutParts[static_cast<int>(EMUnitPartType::Hair)] = InFixture.OutfitHair;
+		}
+
+		if (OutParts[static_cast<int>(EMUnitPartType::Head)] == 0)
+		{
+			if (InFixture.PresetFace > 0)
+			{
+				OutParts[static_cast<int>(EMUnitPartType::Head)] = InFixture.PresetFace;
+			}
+
+			if (InFixture.PresetHair > 0)
+			{
+				OutParts[static_cast<int>(EMUnitPartType::Hair)] = InFixture.PresetHair;
+			}
+		}
+
+		if (InFixture.WeaponCostume > 0)
+		{
+			OutParts[static_cast<int>(EMUnitPartType::Weapon)] = InFixture.WeaponCostume;
+		}
+	}
+}
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FMOutfitPartRulesTest, "MRPG.Outfit.PartRules", EAutomationTestFlags::ApplicationContextMask | EAutomationTestFlags::ProductFilter)
+
+bool FMOutfitPartRulesTest::RunTest(const FString& Parameters)
+{
+	using namespace MOutfitPartRulesTests;
+
+	// 한 배치에 모두 넣어 여러 의상이 서로 섞이지 않는지도 본다.
+	FMOutfitPartBatch Batch;
+	Batch.Reset(UE_ARRAY_COUNT(Fixtures));
+
+	for (int i = 0; i < UE_ARRAY_COUNT(Fixtures); i++)
+	{
+		Gather(Fixtures[i], Batch, i);
+	}
+
+	Batch.Resolve();
+
+	TArray<int> LegacyParts;
+	for (int i = 0; i < UE_ARRAY_COUNT(Fixtures); i++)
+	{
+		const FFixture& Fixture = Fixtures[i];
+		ResolveLegacy(Fixture, LegacyParts);
+
+		for (int Part = 0; Part < UE_ARRAY_COUNT(CheckedParts); Part++)
+		{
+			const EMUnitPartType PartType = CheckedParts[Part];
+			const int Resolved = Batch.GetPart(i, PartType);
+
+			TestEqual(FString::Printf(TEXT("%s: part %d"), Fixture.Name, static_cast<int>(PartType)), Resolved, Fixture.Expected[Part]);
+			TestEqual(FString::Printf(TEXT("%s: part %d matches legacy"), Fixture.Name, static_cast<int>(PartType)), Resolved, LegacyParts[static_cast<int>(PartType)]);
+		}
+	}
+
+	return true;
+}
+
+#endif
@@ -0,0 +1,282 @@
+/***********************************************************************************
+ *                                                                                 *
+ * Copyright. (C) 2023 Mobirix.                                                    *
+ * Website: https://mobirix.com													   *
+ *                                                                                 *
+ ***********************************************************************************/
+
+
+#include "Outfit/MOutfitPreviewCarousel.h"
+
+#include "Core/MMemoryTracker.h"
+#include "Data/MDataManager.h"
+#include "Engine/AssetManager.h"
+#include "HAL/IConsoleManager.h"
+#include "Outfit/FMHeroOutfit.h"
+#include "Outfit/MOutfitMeshMergeCache.h"
+#include "Outfit/MOutfitPartRules.h"
+
+namespace MOutfitPreview
+{
+	int32 Radius = 2;
+	FAutoConsoleVariableRef CVarRadius(TEXT("MOutfit.PreviewRadius"), Radius, TEXT("Number of costumes on each side of the focused preview to prepare in the background."));
+
+	int32 ResolvesPerFrame = 2;
+	FAutoConsoleVariableRef CVarResolvesPerFrame(TEXT("MOutfit.PreviewResolvesPerFrame"), ResolvesPerFrame, TEXT("Number of preview outfits resolved per frame."));
+}
+
+FMOutfitPreviewCarousel::~FMOutfitPreviewCarousel()
+{
+	End();
+}
+
+void FMOutfitPreviewCarousel::Begin(const FMHeroOutfitData& InBase, const TArray<int>& InCostumeTIDs)
+{
+	Reset();
+
+	Epoch.Capture({ EMDataTable::Pawn, EMDataTable::Item, EMDataTable::CustomizingAsset, EMDataTable::CustomizingPreset, EMDataTable::Transform });
+
+	Base = MakeShared<FMHeroOutfitData>(InBase);
+	CostumeTIDs = InCostumeTIDs;
+
+	if (MemoryReporterHandle.IsValid() == false)
+	{
+		MemoryReporterHandle = FMMemoryTracker::Get().AddReporter(EMMemoryTag::HeroOutfitPreview, FMOnReportMemory::CreateRaw(this, &FMOutfitPreviewCarousel::ReportMemory));
+	}
+}
+
+void FMOutfitPreviewCarousel::End()
+{
+	Reset();
+
+	Base.Reset();
+	CostumeTIDs.Reset();
+
+	if (MemoryReporterHandle.IsValid())
+	{
+		FMMemoryTracker::Get().RemoveReporter(MemoryReporterHandle);
+		MemoryReporterHandle.Reset();
+	}
+}
+
+TSharedPtr<const FMHeroOutfitData> FMOutfitPreviewCarousel::Focus(const int InIndex)
+{
+	if (Base.IsValid() == false || CostumeTIDs.IsValidIndex(InIndex) == false)
+	{
+		return nullptr;
+	}
+
+	// 테이블이 다시 읽혔으면 준비해둔 의상은 믿을 수 없다.
+	if (Epoch.IsStale())
+	{
+		const TSharedPtr<FMHeroOutfitData> PreviousBase = Base;
+		Begin(*PreviousBase, TArray<int>(CostumeTIDs));
+	}
+
+	FocusIndex = InIndex;
+
+	FEntry& Entry = Entries.FindOrAdd(InIndex);
+	if (Entry.Outfit.IsValid() == false)
+	{
+		TArray<TSharedPtr<FMHeroOutfitData>> Outfits;
+		ResolvePreviews(*Base, MakeArrayView(&CostumeTIDs[InIndex], 1), Outfits);
+
+		Entry.Outfit = Outfits[0];
+		Prefetch(Entry);
+	}
+
+	const TSharedPtr<const FMHeroOutfitData> Result = Entry.Outfit;
+
+	UpdateWindow();
+
+	return Result;
+}
+
+bool FMOutfitPreviewCarousel::IsPrepared(const int InIndex) const
+{
+	const FEntry* Entry = Entries.Find(InIndex);
+	if (Entry == nullptr || Entry->Outfit.IsValid() == false)
+	{
+		return false;
+	}
+
+	return Entry->LoadHandle.IsValid() == false || Entry->LoadHandle->HasLoadCompleted();
+}
+
+void FMOutfitPreviewCarousel::UpdateWindow()
+{
+	const int Radius = FMath::Max(MOutfitPreview::Radius, 0);
+	const int First = FMath::Max(FocusIndex - Radius, 0);
+	const int Last = FMath::Min(FocusIndex + Radius, CostumeTIDs.Num() - 1);
+
+	// 창을 벗어난 항목은 로딩을 취소하고 버린다.
+	for (auto It = Entries.CreateIterator(); It; ++It)
+	{
+		if (It->Key < First || It->Key > Last)
+		{
+			CancelEntry(It->Value);
+			It.RemoveCurrent();
+		}
+	}
+
+	PendingIndices.Reset();
+	for (int Distance = 1; Distance <= Radius; Distance++)
+	{
+		for (const int Index : { FocusIndex + Distance, FocusIndex - Distance })
+		{
+			if (Index < First || Index > Last)
+			{
+				continue;
+			}
+
+			const FEntry* Entry = Entries.Find(Index);
+			if (Entry == nullptr || Entry->Outfit.IsValid() == false)
+			{
+				PendingIndices.Add(Index);
+			}
+		}
+	}
+
+	if (PendingIndices.Num() > 0 && TickHandle.IsValid() == false)
+	{
+		TickHandle = FTSTicker::GetCoreTicker().AddTicker(FTickerDelegate::CreateRaw(this, &FMOutfitPreviewCarousel::Tick));
+	}
+}
+
+void FMOutfitPreviewCarousel::Prefetch(FEntry& InEntry)
+{
+	TArray<FSoftObjectPath> Paths;
+	GatherPartAssets(*InEntry.Outfit, Paths);
+
+	if (Paths.Num() == 0)
+	{
+		return;
+	}
+
+	InEntry.LoadHandle = UAssetManager::GetStreamableManager().RequestAsyncLoad(MoveTemp(Paths), FStreamableDelegate(), FStreamableManager::DefaultAsyncLoadPriority);
+}
+
+void FMOutfitPreviewCarousel::CancelEntry(FEntry& InEntry)
+{
+	if (InEntry.LoadHandle.IsValid())
+	{
+		InEntry.LoadHandle->CancelHandle();
+		InEntry.LoadHandle.Reset();
+	}
+}
+
+void FMOutfitPreviewCarousel::Reset()
+{
+	if (TickHandle.IsValid())
+	{
+		FTSTicker::GetCoreTicker().RemoveTicker(TickHandle);
+		TickHandle.Reset();
+	}
+
+	for (TPair<int, FEntry>& Pair : Entries)
+	{
+		CancelEntry(Pair.Value);
+	}
+
+	Entries.Reset();
+	PendingIndices.Reset();
+	FocusIndex = INDEX_NONE;
+}
+
+bool FMOutfitPreviewCarousel::Tick(float InDeltaTime)
+{
+	TRACE_CPUPROFILER_EVENT_SCOPE(MOutfitPreview_Tick);
+
+	if (Base.IsValid() == false || PendingIndices.Num() == 0)
+	{
+		TickHandle.Reset();
+		return false;
+	}
+
+	const int Count = FMath::Min(FMath::Max(MOutfitPreview::ResolvesPerFrame, 1), PendingIndices.Num());
+
+	TArray<int, TInlineAllocator<8>> TIDs;
+	for (int i = 0; i < Count; i++)
+	{
+		TIDs.Add(CostumeTIDs[PendingIndices[i]]);
+	}
+
+	TArray<TSharedPtr<FMHeroOutfitData>> Outfits;
+	ResolvePreviews(*Base, TIDs, Outfits);
+
+	for (int i = 0; i < Count; i++)
+	{
+		FEntry& Entry = Entries.FindOrAdd(PendingIndices[i]);
+		Entry.Outfit = Outfits[i];
+		Prefetch(Entry);
+	}
+
+	PendingIndices.RemoveAt(0, Count, false);
+
+	if (PendingIndices.Num() > 0)
+	{
+		return true;
+	}
+
+	TickHandle.Reset();
+	return false;
+}
+
+void FMOutfitPreviewCarousel::ReportMemory(FMMemoryReport& OutReport) const
+{
+	// 의상 자체의 크기는 FMHeroOutfitData가 스스로 등록해 HeroOutfit 태그로 잡힌다.
+	const SIZE_T Bytes = Entries.GetAllocatedSize() + PendingIndices.GetAllocatedSize() + CostumeTIDs.GetAllocatedSize();
+	int Count = 0;
+
+	for (const TPair<int, FEntry>& Pair : Entries)
+	{
+		if (Pair.Value.Outfit.IsValid())
+		{
+			Count++;
+		}
+	}
+
+	OutReport.Add(Count, Bytes);
+}
+
+void FMOutfitPreviewCarousel::ResolvePreviews(const FMHeroOutfitData& InBase, TArrayView<const int> InCostumeTIDs, TArray<TSharedPtr<FMHeroOutfitData>>& OutOutfits)
+{
+	TRACE_CPUPROFILER_EVENT_SCOPE(MOutfitPreview_Resolve);
+
+	OutOutfits.Reset(InCostumeTIDs.Num());
+
+	TArray<FMHeroOutfitData*, TInlineAllocator<8>> Outfits;
+	for (const int CostumeTID : InCostumeTIDs)
+	{
+		// SetCostume과 같지만 Update는 한번에 돌린다.
+		TSharedPtr<FMHeroOutfitData> Outfit = MakeShared<FMHeroOutfitData>(InBase);
+		Outfit->OutfitData = MDATAMGR->GetPawnData(CostumeTID > 0 ? CostumeTID : InBase.BasePawnTID);
+
+		Outfits.Add(Outfit.Get());
+		OutOutfits.Emplace(MoveTemp(Outfit));
+	}
+
+	FMOutfitPartBatch::UpdateOutfits(Outfits);
+}
+
+void FMOutfitPreviewCarousel::GatherPartAssets(const FMHeroOutfitData& InOutfit, TArray<FSoftObjectPath>& OutPaths)
+{
+	if (FMOutfitMeshMergeCache::OnResolvePartMesh.IsBound() == false)
+	{
+		return;
+	}
+
+	for (const int MeshID : InOutfit.Parts)
+	{
+		if (MeshID <= 0)
+		{
+			continue;
+		}
+
+		const FSoftObjectPath Path = FMOutfitMeshMergeCache::OnResolvePartMesh.Execute(MeshID);
+		if (Path.IsNull() == false)
+		{
+			OutPaths.AddUnique(Path);
+		}
+	}
+}
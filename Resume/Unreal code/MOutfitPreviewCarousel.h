@@ -0,0 +1,88 @@
+/***********************************************************************************
+ *                                                                                 *
+ * Copyright. (C) 2023 Mobirix.                                                    *
+ * Website: https://mobirix.com													   *
+ *                                                                                 *
+ ***********************************************************************************/
+
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Containers/Ticker.h"
+#include "Data/MDataEpoch.h"
+#include "Engine/StreamableManager.h"
+
+struct FMHeroOutfitData;
+struct FMMemoryReport;
+
+// 코스튬 목록을 넘겨볼 때 쓰는 미리보기 준비기.
+// 지금 보는 코스튬 양옆(MOutfit.PreviewRadius)의 의상을 플레이어의 커스터마이징과 무기 코스튬으로
+// 미리 계산하고 파츠 어셋을 읽어둔다. 창 밖으로 벗어난 항목은 계산과 로딩을 취소한다.
+//
+// 예)
+//	Carousel.Begin(HeroOutfit, CostumeTIDs);
+//	if (TSharedPtr<const FMHeroOutfitData> Preview = Carousel.Focus(Index))
+//	{
+//		PreviewOutfit = *Preview;
+//	}
+class MRPG_API FMOutfitPreviewCarousel
+{
+public:
+	~FMOutfitPreviewCarousel();
+
+	// InBase의 커스터마이징과 무기 코스튬으로 InCostumeTIDs를 미리본다.
+	void Begin(const FMHeroOutfitData& InBase, const TArray<int>& InCostumeTIDs);
+
+	void End();
+
+	// 준비된 의상을 돌려준다. 아직이면 그 자리에서 계산하고, 주변 항목의 준비를 예약한다.
+	TSharedPtr<const FMHeroOutfitData> Focus(const int InIndex);
+
+	// 의상 계산과 파츠 어셋 로딩이 모두 끝났다.
+	bool IsPrepared(const int InIndex) const;
+
+	bool IsActive() const { return Base.IsValid(); }
+
+	static void ResolvePreviews(const FMHeroOutfitData& InBase, TArrayView<const int> InCostumeTIDs, TArray<TSharedPtr<FMHeroOutfitData>>& OutOutfits);
+
+	static void GatherPartAssets(const FMHeroOutfitData& InOutfit, TArray<FSoftObjectPath>& OutPaths);
+
+private:
+	struct FEntry
+	{
+		TSharedPtr<FMHeroOutfitData> Outfit;
+
+		TSharedPtr<FStreamableHandle> LoadHandle;
+	};
+
+	void UpdateWindow();
+
+	void Prefetch(FEntry& InEntry);
+
+	void CancelEntry(FEntry& InEntry);
+
+	void Reset();
+
+	bool Tick(float InDeltaTime);
+
+	void ReportMemory(FMMemoryReport& OutReport) const;
+
+	TSharedPtr<FMHeroOutfitData> Base;
+
+	TArray<int> CostumeTIDs;
+
+	int FocusIndex = INDEX_NONE;
+
+	// 목록 인덱스별 준비 상태
+	TMap<int, FEntry> Entries;
+
+	// 계산을 기다리는 목록 인덱스. 포커스에서 가까운 순이다.
+	TArray<int> PendingIndices;
+
+	FMDataEpochStamp Epoch;
+
+	FTSTicker::FDelegateHandle TickHandle;
+
+	FDelegateHandle MemoryReporterHandle;
+};
@@ -0,0 +1,283 @@
+/***********************************************************************************
+ *                                                                                 *
+ * Copyright. (C) 2023 Mobirix.                                                    *
+ * Website: https://mobirix.com													   *
+ *                                                                                 *
+ ***********************************************************************************/
+
+
+#include "Synthesis/MPawnInventorySnapshot.h"
+
+#include "Algo/BinarySearch.h"
+#include "Data/MDataManager.h"
+#include "Data/Base/MdataStruct.h"
+#include "Network/Data/MNetworkDataManager.h"
+#include "Synthesis/MSynthesisModel.h"
+
+namespace MPawnInventorySnapshot
+{
+	uint32 NextVersion = 0;
+
+	int GetPredictedCount(const int InTID, const TMap<int, int>& InPredictedConsume)
+	{
+		const int* Predicted = InPredictedConsume.Find(InTID);
+		return MNETDATAMGR->GetNetPawnHaveCount(InTID) - (Predicted ? *Predicted : 0);
+	}
+}
+
+TSharedRef<const FMPawnInventorySnapshot> FMPawnInventorySnapshot::Build(const EMPawnType InPawnType, const TMap<int, int>& InPredictedConsume, const TSharedPtr<const FMPawnInventorySnapshot>& InPrevious, const IMSynthesisDataProvider* InData)
+{
+	const TArray<int>& HaveArr = MNETDATAMGR->GetHaveNetPawnArr(InPawnType);
+
+	TArray<TPair<int, int>> Counts;
+	Counts.Reserve(HaveArr.Num());
+	for (const int TID : HaveArr)
+	{
+		Counts.Emplace(TID, MPawnInventorySnapshot::GetPredictedCount(TID, InPredictedConsume));
+	}
+
+	return Create(InPawnType, Counts, InPrevious, InData);
+}
+
+TSharedRef<const FMPawnInventorySnapshot> FMPawnInventorySnapshot::Create(const EMPawnType InPawnType, const TArray<TPair<int, int>>& InCounts, const TSharedPtr<const FMPawnInventorySnapshot>& InPrevious, const IMSynthesisDataProvider* InData)
+{
+	struct FEntry
+	{
+		int TID;
+		int Count;
+		int Grade;
+	};
+
+	TArray<FEntry> Entries;
+	Entries.Reserve(InCounts.Num());
+	for (const TPair<int, int>& Pair : InCounts)
+	{
+		FEntry& Entry = Entries.AddDefaulted_GetRef();
+		Entry.TID = Pair.Key;
+		Entry.Count = Pair.Value;
+		Entry.Grade = INDEX_NONE;
+
+		if (InData)
+		{
+			FMSynthesisPawnInfo PawnInfo;
+			if (InData->FindPawn(Pair.Key, PawnInfo))
+			{
+				Entry.Grade = PawnInfo.Grade;
+			}
+		}
+		else if (const FMPawnData* PawnData = MDATAMGR->GetPawnData(Pair.Key))
+		{
+			Entry.Grade = static_cast<int>(PawnData->Grade);
+		}
+	}
+
+	Entries.Sort([ ] (const FEntry& A, const FEntry& B)
+	{
+		return A.Grade != B.Grade ? A.Grade < B.Grade : A.TID < B.TID;
+	});
+
+	TSharedRef<FMPawnInventorySnapshot> Snapshot = MakeShared<FMPawnInventorySnapshot>();
+	Snapshot->PawnType = InPawnType;
+
+	const int GradeCount = static_cast<int>(EMGrade::Legendary) + 1;
+	Snapshot->TIDs.Reserve(Entries.Num());
+	Snapshot->Counts.Reserve(Entries.Num());
+	Snapshot->Grades.Reserve(Entries.Num());
+	Snapshot->GradeOffsets.Init(0, GradeCount + 1);
+
+	for (const FEntry& Entry : Entries)
+	{
+		Snapshot->TIDs.Emplace(Entry.TID);
+		Snapshot->Counts.Emplace(Entry.Count);
+		Snapshot->Grades.Emplace(Entry.Grade);
+	}
+
+	// 등급별 시작 위치. 데이터가 없는 TID(INDEX_NONE)는 맨 앞에 모여 있어 어느 구간에도 속하지 않는다.
+	int Index = 0;
+	for (int Grade = 0; Grade <= GradeCount; Grade++)
+	{
+		while (Index < Entries.Num() && Entries[Index].Grade < Grade)
+		{
+			Index++;
+		}
+		Snapshot->GradeOffsets[Grade] = Index;
+	}
+
+	Snapshot->TIDOrder.Reserve(Entries.Num());
+	for (int i = 0; i < Entries.Num(); i++)
+	{
+		Snapshot->TIDOrder.Emplace(i);
+	}
+	Snapshot->TIDOrder.Sort([ &Snapshot ] (const int A, const int B)
+	{
+		return Snapshot->TIDs[A] < Snapshot->TIDs[B];
+	});
+
+	if (InPrevious.IsValid() && InPrevious->HasSameContents(*Snapshot))
+	{
+		return InPrevious.ToSharedRef();
+	}
+
+	Snapshot->Version = ++MPawnInventorySnapshot::NextVersion;
+	return Snapshot;
+}
+
+TSharedRef<const FMPawnInventorySnapshot> FMPawnInventorySnapshot::Update(const TSharedRef<const FMPawnInventorySnapshot>& InPrevious, const TArray<int>& InDirtyTIDs, const TMap<int, int>& InPredictedConsume, const IMSynthesisDataProvider* InData)
+{
+	TSharedPtr<FMPawnInventorySnapshot> Snapshot;
+
+	for (const int TID : InDirtyTIDs)
+	{
+		const int Index = InPrevious->FindIndex(TID);
+		if (Index == INDEX_NONE)
+		{
+			// 새로 얻은 TID는 정렬 위치가 바뀌므로 처음부터 다시 만든다.
+			return Build(InPrevious->PawnType, InPredictedConsume, InPrevious, InData);
+		}
+
+		const int Count = MPawnInventorySnapshot::GetPredictedCount(TID, InPredictedConsume);
+		if (Count == InPrevious->Counts[Index])
+		{
+			continue;
+		}
+
+		if (Snapshot.IsValid() == false)
+		{
+			Snapshot = MakeShared<FMPawnInventorySnapshot>(*InPrevious);
+		}
+
+		Snapshot->Counts[Index] = Count;
+	}
+
+	if (Snapshot.IsValid() == false)
+	{
+		return InPrevious;
+	}
+
+	Snapshot->Version = ++MPawnInventorySnapshot::NextVersion;
+	return Snapshot.ToSharedRef();
+}
+
+int FMPawnInventorySnapshot::GetCount(const int InTID) const
+{
+	const int Index = FindIndex(InTID);
+	return Index != INDEX_NONE ? Counts[Index] : 0;
+}
+
+int FMPawnInventorySnapshot::FindIndex(const int InTID) const
+{
+	const int OrderIndex = Algo::BinarySearchBy(TIDOrder, InTID, [ this ] (const int InIndex)
+	{
+		return TIDs[InIndex];
+	});
+
+	return OrderIndex != INDEX_NONE ? TIDOrder[OrderIndex] : INDEX_NONE;
+}
+
+void FMPawnInventorySnapshot::GetGradeRange(const EMGrade InGrade, int& OutBegin, int& OutEnd) const
+{
+	const int Grade = static_cast<int>(InGrade);
+	if (GradeOffsets.IsValidIndex(Grade + 1) == false)
+	{
+		OutBegin = OutEnd = 0;
+		return;
+	}
+
+	OutBegin = GradeOffsets[Grade];
+	OutEnd = GradeOffsets[Grade + 1];
+}
+
+int FMPawnInventorySnapshot::GetSurplusCount(const EMGrade InGrade) const
+{
+	int Begin, End;
+	GetGradeRange(InGrade, Begin, End);
+
+	const int* CountData = Counts.GetData();
+
+	int Surplus = 0;
+	for (int i = Begin; i < End; i++)
+	{
+		Surplus += FMath::Max(CountData[i] - 1, 0);
+	}
+
+	return Surplus;
+}
+
+void FMPawnInventorySnapshot::GetSurplusByGrade(TArray<int>& OutSurplusByGrade) const
+{
+	const int GradeCount = GradeOffsets.Num() - 1;
+	OutSurplusByGrade.Init(0, FMath::Max(GradeCount, 0));
+
+	const int* CountData = Counts.GetData();
+	for (int Grade = 0; Grade < GradeCount; Grade++)
+	{
+		int Surplus = 0;
+		for (int i = GradeOffsets[Grade]; i < GradeOffsets[Grade + 1]; i++)
+		{
+			Surplus += FMath::Max(CountData[i] - 1, 0);
+		}
+		OutSurplusByGrade[Grade] = Surplus;
+	}
+}
+
+int FMPawnInventorySnapshot::GetSurplusTIDs(const EMGrade InGrade, TArray<int>& OutTIDs) const
+{
+	int Begin, End;
+	GetGradeRange(InGrade, Begin, End);
+
+	const int PrevNum = OutTIDs.Num();
+	for (int i = Begin; i < End; i++)
+	{
+		if (Counts[i] > 1)
+		{
+			OutTIDs.Emplace(TIDs[i]);
+		}
+	}
+
+	return OutTIDs.Num() - PrevNum;
+}
+
+bool FMPawnInventorySnapshot::HasSameContents(const FMPawnInventorySnapshot& InOther) const
+{
+	return PawnType == InOther.PawnType &&
+		TIDs == InOther.TIDs &&
+		Counts == InOther.Counts &&
+		Grades == InOther.Grades;
+}
+
+void FMPawnInventorySnapshot::GetChangedTIDs(const FMPawnInventorySnapshot& InOld, TArray<int>& OutChangedTIDs) const
+{
+	// 두 스냅샷을 TID 오름차순으로 병합하며 비교한다.
+	int i = 0;
+	int j = 0;
+	while (i < TIDOrder.Num() || j < InOld.TIDOrder.Num())
+	{
+		const int NewIndex = i < TIDOrder.Num() ? TIDOrder[i] : INDEX_NONE;
+		const int OldIndex = j < InOld.TIDOrder.Num() ? InOld.TIDOrder[j] : INDEX_NONE;
+
+		if (OldIndex == INDEX_NONE || (NewIndex != INDEX_NONE && TIDs[NewIndex] < InOld.TIDs[OldIndex]))
+		{
+			OutChangedTIDs.Emplace(TIDs[NewIndex]);
+			i++;
+		}
+		else if (NewIndex == INDEX_NONE || InOld.TIDs[OldIndex] < TIDs[NewIndex])
+		{
+			OutChangedTIDs.Emplace(InOld.TIDs[OldIndex]);
+			j++;
+		}
+		else
+		{
+			if (Counts[NewIndex] != InOld.Counts[OldIndex] || Grades[NewIndex] != InOld.Grades[OldIndex])
+			{
+				OutChangedTIDs.Emplace(TIDs[NewIndex]);
+			}
+			i++;
+			j++;
+		}
+	}
+}
+
+SIZE_T FMPawnInventorySnapshot::GetAllocatedSize() const
+{
+	return TIDs.GetAllocatedSize() + Counts.GetAllocatedSize() + Grades.GetAllocatedSize() + GradeOffsets.GetAllocatedSize() + TIDOrder.GetAllocatedSize();
+}
@@ -0,0 +1,83 @@
+/***********************************************************************************
+ *                                                                                 *
+ * Copyright. (C) 2023 Mobirix.                                                    *
+ * Website: https://mobirix.com													   *
+ *                                                                                 *
+ ***********************************************************************************/
+
+
+#pragma once
+
+#include "CoreMinimal.h"
+
+enum class EMGrade : uint8;
+enum class EMPawnType : uint8;
+class IMSynthesisDataProvider;
+
+// 보유 펫/영웅/탈것 수량의 불변 스냅샷.
+// TID, 수량, 등급을 등급 -> TID 순으로 정렬된 병렬 배열에 담아 등급 단위 집계를 연속 구간 순회로 처리한다.
+// 내용이 바뀔 때만 버전이 올라간다.
+struct MRPG_API FMPawnInventorySnapshot
+{
+public:
+	// InData가 있으면 폰 등급을 MDATAMGR 대신 InData에서 찾는다.
+	static TSharedRef<const FMPawnInventorySnapshot> Build(const EMPawnType InPawnType, const TMap<int, int>& InPredictedConsume, const TSharedPtr<const FMPawnInventorySnapshot>& InPrevious, const IMSynthesisDataProvider* InData = nullptr);
+
+	// 보유 목록을 MNETDATAMGR 대신 (TID, 수량) 목록으로 받는다. 벤치마크와 테스트에서 쓴다.
+	static TSharedRef<const FMPawnInventorySnapshot> Create(const EMPawnType InPawnType, const TArray<TPair<int, int>>& InCounts, const TSharedPtr<const FMPawnInventorySnapshot>& InPrevious, const IMSynthesisDataProvider* InData = nullptr);
+
+	// InDirtyTIDs의 수량만 다시 읽어 이전 스냅샷에 덮어쓴다. 정렬은 그대로 둔다.
+	// 이전 스냅샷에 없는 TID가 있으면 Build로 처음부터 만든다. 수량이 0이 된 TID는 빠지지 않고 남는다.
+	static TSharedRef<const FMPawnInventorySnapshot> Update(const TSharedRef<const FMPawnInventorySnapshot>& InPrevious, const TArray<int>& InDirtyTIDs, const TMap<int, int>& InPredictedConsume, const IMSynthesisDataProvider* InData = nullptr);
+
+	int GetCount(const int InTID) const;
+
+	int FindIndex(const int InTID) const;
+
+	void GetGradeRange(const EMGrade InGrade, int& OutBegin, int& OutEnd) const;
+
+	// 등급 구간에서 TID별로 1개씩 남긴 나머지 수량의 합
+	int GetSurplusCount(const EMGrade InGrade) const;
+
+	// 모든 등급의 나머지 수량 합을 한번의 순회로 구한다. 인덱스는 등급 값
+	void GetSurplusByGrade(TArray<int>& OutSurplusByGrade) const;
+
+	int GetSurplusTIDs(const EMGrade InGrade, TArray<int>& OutTIDs) const;
+
+	int Num() const { return TIDs.Num(); }
+
+	const TArray<int>& GetTIDs() const { return TIDs; }
+
+	const TArray<int>& GetCounts() const { return Counts; }
+
+	const TArray<int>& GetGrades() const { return Grades; }
+
+	EMPawnType GetPawnType() const { return PawnType; }
+
+	uint32 GetVersion() const { return Version; }
+
+	bool HasSameContents(const FMPawnInventorySnapshot& InOther) const;
+
+	// 새로 생기거나 없어졌거나, 개수나 등급이 바뀐 TID를 모은다.
+	void GetChangedTIDs(const FMPawnInventorySnapshot& InOld, TArray<int>& OutChangedTIDs) const;
+
+	SIZE_T GetAllocatedSize() const;
+
+private:
+	EMPawnType PawnType = static_cast<EMPawnType>(0);
+
+	uint32 Version = 0;
+
+	TArray<int> TIDs;
+
+	TArray<int> Counts;
+
+	// 폰 데이터가 없는 TID는 INDEX_NONE
+	TArray<int> Grades;
+
+	// 등급 g의 구간은 [GradeOffsets[g], GradeOffsets[g + 1])
+	TArray<int> GradeOffsets;
+
+	// TID 오름차순으로 정렬된 열 인덱스
+	TArray<int> TIDOrder;
+};
@@ -0,0 +1,96 @@
+/***********************************************************************************
+ *                                                                                 *
+ * Copyright. (C) 2023 Mobirix.                                                    *
+ * Website: https://mobirix.com													   *
+ *                                                                                 *
+ ***********************************************************************************/
+
+
+#include "Synthesis/MRewardAssetPrefetcher.h"
+
+#include "Data/MDataManager.h"
+#include "Data/Base/MdataStruct.h"
+#include "Engine/AssetManager.h"
+#include "Outfit/MOutfitMeshMergeCache.h"
+
+FMOnCollectPawnAssets FMRewardAssetPrefetcher::OnCollectPawnAssets;
+FMOnCollectSynthesisRewardPool FMRewardAssetPrefetcher::OnCollectSynthesisRewardPool;
+
+void FMRewardAssetPrefetcher::CollectPawnAssets(const FMPawnData& InPawnData, TArray<FSoftObjectPath>& OutAssets)
+{
+	const FSoftObjectPath IconPath(InPawnData.Icon);
+	if (IconPath.IsNull() == false)
+	{
+		OutAssets.AddUnique(IconPath);
+	}
+
+	// 파츠 메시는 의상 메시 병합과 같은 경로로 찾는다.
+	if (FMOutfitMeshMergeCache::OnResolvePartMesh.IsBound())
+	{
+		for (const int MeshID : { InPawnData.WeaponMeshID, InPawnData.BodyMeshID, InPawnData.HelmetMeshID, InPawnData.HairMeshID })
+		{
+			if (MeshID <= 0)
+			{
+				continue;
+			}
+
+			const FSoftObjectPath MeshPath = FMOutfitMeshMergeCache::OnResolvePartMesh.Execute(MeshID);
+			if (MeshPath.IsNull() == false)
+			{
+				OutAssets.AddUnique(MeshPath);
+			}
+		}
+	}
+
+	OnCollectPawnAssets.Broadcast(InPawnData, OutAssets);
+}
+
+void FMRewardAssetPrefetcher::CollectRewardPool(const EMPawnType InPawnType, const EMGrade InGrade, TArray<int>& OutPawnTIDs)
+{
+	for (const TPair<int, const FMPawnData*> Pair : MDATAMGR->GetPawnMap())
+	{
+		if (Pair.Value && Pair.Value->PawnType == InPawnType && Pair.Value->Grade == InGrade)
+		{
+			OutPawnTIDs.Emplace(Pair.Key);
+		}
+	}
+
+	OnCollectSynthesisRewardPool.Broadcast(InPawnType, InGrade, OutPawnTIDs);
+}
+
+TSharedPtr<FStreamableHandle> FMRewardAssetPrefetcher::Prefetch(const TArray<int>& InPawnTIDs, const TAsyncLoadPriority InPriority)
+{
+	TArray<FSoftObjectPath> Assets;
+	for (const int TID : InPawnTIDs)
+	{
+		if (const FMPawnData* PawnData = MDATAMGR->GetPawnData(TID))
+		{
+			CollectPawnAssets(*PawnData, Assets);
+		}
+	}
+
+	Assets.RemoveAll([ ] (const FSoftObjectPath& Path)
+	{
+		return Path.IsNull();
+	});
+
+	if (Assets.Num() <= 0)
+	{
+		return nullptr;
+	}
+
+	return UAssetManager::GetStreamableManager().RequestAsyncLoad(MoveTemp(Assets), FStreamableDelegate(), InPriority);
+}
+
+TSharedPtr<FStreamableHandle> FMRewardAssetPrefetcher::PrefetchRewardPool(const EMPawnType InPawnType, const EMGrade InGrade)
+{
+	TArray<int> PawnTIDs;
+	CollectRewardPool(InPawnType, InGrade, PawnTIDs);
+
+	if (PawnTIDs.Num() <= 0)
+	{
+		return nullptr;
+	}
+
+	return Prefetch(PawnTIDs, FStreamableManager::DefaultAsyncLoadPriority);
+}
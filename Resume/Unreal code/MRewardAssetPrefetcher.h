@@ -0,0 +1,42 @@
+/***********************************************************************************
+ *                                                                                 *
+ * Copyright. (C) 2023 Mobirix.                                                    *
+ * Website: https://mobirix.com													   *
+ *                                                                                 *
+ ***********************************************************************************/
+
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Engine/StreamableManager.h"
+
+enum class EMGrade : uint8;
+enum class EMPawnType : uint8;
+struct FMPawnData;
+
+// 기본 수집(아이콘, 파츠 메시) 외에 더 읽어둘 어셋(의상 등)을 모은다. 어셋을 소유한 쪽에서 바인드한다.
+DECLARE_MULTICAST_DELEGATE_TwoParams(FMOnCollectPawnAssets, const FMPawnData& /*InPawnData*/, TArray<FSoftObjectPath>& /*OutAssets*/);
+
+// 기본 보상 후보(같은 폰 종류, 보상 등급의 폰) 목록을 고치거나 더한다.
+DECLARE_MULTICAST_DELEGATE_ThreeParams(FMOnCollectSynthesisRewardPool, const EMPawnType /*InPawnType*/, const EMGrade /*InGrade*/, TArray<int>& /*OutPawnTIDs*/);
+
+// 합성 보상 연출 전에 보상 폰 어셋을 비동기로 읽어둔다.
+class MRPG_API FMRewardAssetPrefetcher
+{
+public:
+	static FMOnCollectPawnAssets OnCollectPawnAssets;
+
+	static FMOnCollectSynthesisRewardPool OnCollectSynthesisRewardPool;
+
+	// 폰 데이터의 아이콘과 파츠 메시를 모은 뒤 OnCollectPawnAssets로 더 모은다.
+	static void CollectPawnAssets(const FMPawnData& InPawnData, TArray<FSoftObjectPath>& OutAssets);
+
+	// 폰 데이터에서 같은 종류, 같은 등급의 폰을 모은 뒤 OnCollectSynthesisRewardPool로 고친다.
+	static void CollectRewardPool(const EMPawnType InPawnType, const EMGrade InGrade, TArray<int>& OutPawnTIDs);
+
+	static TSharedPtr<FStreamableHandle> Prefetch(const TArray<int>& InPawnTIDs, const TAsyncLoadPriority InPriority = FStreamableManager::AsyncLoadHighPriority);
+
+	// 응답을 기다리는 동안 나올 가능성이 있는 보상을 낮은 우선순위로 미리 읽는다.
+	static TSharedPtr<FStreamableHandle> PrefetchRewardPool(const EMPawnType InPawnType, const EMGrade InGrade);
+};
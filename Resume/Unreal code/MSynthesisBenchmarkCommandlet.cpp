@@ -0,0 +1,456 @@
+/***********************************************************************************
+ *                                                                                 *
+ * Copyright. (C) 2023 Mobirix.                                                    *
+ * Website: https://mobirix.com													   *
+ *                                                                                 *
+ ***********************************************************************************/
+
+
+#include "Synthesis/MSynthesisBenchmarkCommandlet.h"
+
+#include "Data/Base/MdataStruct.h"
+#include "Data/MDenseTIDTable.h"
+#include "Math/RandomStream.h"
+#include "Synthesis/MPawnInventorySnapshot.h"
+#include "Synthesis/MSynthesisPlanner.h"
+#include "Synthesis/MSynthesisModel.h"
+#include "Synthesis/MSynthesisRedDot.h"
+
+DEFINE_LOG_CATEGORY_STATIC(LogMSynthesisBenchmark, Log, All);
+
+namespace MSynthesisBenchmark
+{
+	constexpr int GradeCount = 5;
+	constexpr int MaterialCount = 4;
+	constexpr int MaxSynthesisCount = 11;
+
+	class FInventory : public IMSynthesisInventoryProvider
+	{
+	public:
+		virtual int GetHaveCount(const int InTID) const override
+		{
+			const int* Count = Counts.Find(InTID);
+			return Count ? *Count : 0;
+		}
+
+		TMap<int, int> Counts;
+	};
+
+	class FData : public IMSynthesisDataProvider
+	{
+	public:
+		FData()
+		{
+			for (int Grade = 0; Grade < GradeCount - 1; Grade++)
+			{
+				FMSynthesisRecipe& Recipe = Recipes.AddDefaulted_GetRef();
+				Recipe.SynthesisTID = Grade + 1;
+				Recipe.Grade = Grade;
+				Recipe.MaterialCount = MaterialCount;
+				Recipe.UpgradeRate = 0.25;
+			}
+		}
+
+		virtual bool FindPawn(const int InTID, FMSynthesisPawnInfo& OutPawn) const override
+		{
+			OutPawn.PawnType = 0;
+			OutPawn.Grade = InTID % GradeCount;
+			return InTID > 0;
+		}
+
+		virtual const FMSynthesisRecipe* FindRecipe(const int InSynthesisTID) const override
+		{
+			return Recipes.IsValidIndex(InSynthesisTID - 1) ? &Recipes[InSynthesisTID - 1] : nullptr;
+		}
+
+		virtual const FMSynthesisRecipe* FindRecipeOfPawn(const FMSynthesisPawnInfo& InPawn) const override
+		{
+			return Recipes.IsValidIndex(InPawn.Grade) ? &Recipes[InPawn.Grade] : nullptr;
+		}
+
+		TArray<FMSynthesisRecipe> Recipes;
+	};
+
+	// 폰 데이터 크기의 레코드
+	struct FLookupRecord
+	{
+		int TID = 0;
+		int PawnType = 0;
+		int Grade = 0;
+		int Values[13] = {};
+	};
+
+	void RunLookupBenchmark(const int InRecordCount, const int InTIDStride, const int InLookupCount)
+	{
+		TMap<int, FLookupRecord> Map;
+		TArray<TPair<int, FLookupRecord>> Records;
+		Map.Reserve(InRecordCount);
+		Records.Reserve(InRecordCount);
+
+		for (int i = 0; i < InRecordCount; i++)
+		{
+			FLookupRecord Record;
+			Record.TID = 100000 + i * InTIDStride;
+			Record.Grade = i % GradeCount;
+
+			Map.Emplace(Record.TID, Record);
+			Records.Emplace(Record.TID, Record);
+		}
+
+		TMDenseTIDTable<FLookupRecord> Table;
+		double Start = FPlatformTime::Seconds();
+		Table.Build(MoveTemp(Records));
+		const double TableBuildSeconds = FPlatformTime::Seconds() - Start;
+
+		FRandomStream Stream(InRecordCount);
+		TArray<int> Keys;
+		Keys.Reserve(InLookupCount);
+		for (int i = 0; i < InLookupCount; i++)
+		{
+			Keys.Emplace(100000 + Stream.RandRange(0, InRecordCount - 1) * InTIDStride);
+		}
+
+		int64 MapSum = 0;
+		Start = FPlatformTime::Seconds();
+		for (const int Key : Keys)
+		{
+			if (const FLookupRecord* Record = Map.Find(Key))
+			{
+				MapSum += Record->Grade;
+			}
+		}
+		const double MapSeconds = FPlatformTime::Seconds() - Start;
+
+		int64 TableSum = 0;
+		Start = FPlatformTime::Seconds();
+		for (const int Key : Keys)
+		{
+			if (const FLookupRecord* Record = Table.Find(Key))
+			{
+				TableSum += Record->Grade;
+			}
+		}
+		const double TableSeconds = FPlatformTime::Seconds() - Start;
+
+		check(MapSum == TableSum);
+
+		const double Divider = FMath::Max(InLookupCount, 1) / 1000000000.0;
+		UE_LOG(LogMSynthesisBenchmark, Display, TEXT("Lookup Records=%d Stride=%d %s : map %.2f ns, table %.2f ns, table build %.2f ms, bytes map %llu table %llu"),
+			InRecordCount, InTIDStride, Table.IsDense() ? TEXT("dense") : TEXT("sorted"),
+			MapSeconds / Divider, TableSeconds / Divider, TableBuildSeconds * 1000.0,
+			static_cast<uint64>(Map.GetAllocatedSize()), static_cast<uint64>(Table.GetAllocatedSize()));
+	}
+
+	void RunInventoryScanBenchmark(const int InPawnCount, const int InIterations)
+	{
+		FData Data;
+		TArray<int> HaveArr;
+		TMap<int, int> CountMap;
+		TArray<TPair<int, int>> Counts;
+
+		FRandomStream Stream(InPawnCount);
+		for (int TID = 1; TID <= InPawnCount; TID++)
+		{
+			const int Count = Stream.RandRange(1, 6);
+			HaveArr.Emplace(TID);
+			CountMap.Emplace(TID, Count);
+			Counts.Emplace(TID, Count);
+		}
+
+		double Start = FPlatformTime::Seconds();
+		const TSharedRef<const FMPawnInventorySnapshot> Snapshot = FMPawnInventorySnapshot::Create(static_cast<EMPawnType>(0), Counts, nullptr, &Data);
+		const double SnapshotSeconds = FPlatformTime::Seconds() - Start;
+
+		double LookupSeconds = 0.0;
+		double ScanSeconds = 0.0;
+		int64 LookupSum = 0;
+		int64 ScanSum = 0;
+		TArray<int> SurplusByGrade;
+		TArray<int> SurplusTIDs;
+
+		for (int Iteration = 0; Iteration < InIterations; Iteration++)
+		{
+			// 기존 방식: 보유 TID마다 수량과 폰 데이터를 찾아 등급별 나머지 수량과 목록 필터를 구한다.
+			Start = FPlatformTime::Seconds();
+			int LookupSurplus[GradeCount] = {};
+			SurplusTIDs.Reset();
+			for (const int TID : HaveArr)
+			{
+				const int* Count = CountMap.Find(TID);
+				FMSynthesisPawnInfo Pawn;
+				if (Count && Data.FindPawn(TID, Pawn))
+				{
+					LookupSurplus[Pawn.Grade] += FMath::Max(*Count - 1, 0);
+					if (*Count > 1)
+					{
+						SurplusTIDs.Emplace(TID);
+					}
+				}
+			}
+			LookupSeconds += FPlatformTime::Seconds() - Start;
+
+			for (const int Surplus : LookupSurplus)
+			{
+				LookupSum += Surplus;
+			}
+			LookupSum += SurplusTIDs.Num();
+
+			// 스냅샷: 등급 구간의 수량 열만 연속으로 훑는다.
+			Start = FPlatformTime::Seconds();
+			Snapshot->GetSurplusByGrade(SurplusByGrade);
+			SurplusTIDs.Reset();
+			for (int Grade = 0; Grade < GradeCount; Grade++)
+			{
+				Snapshot->GetSurplusTIDs(static_cast<EMGrade>(Grade), SurplusTIDs);
+			}
+			ScanSeconds += FPlatformTime::Seconds() - Start;
+
+			for (const int Surplus : SurplusByGrade)
+			{
+				ScanSum += Surplus;
+			}
+			ScanSum += SurplusTIDs.Num();
+		}
+
+		check(LookupSum == ScanSum);
+
+		const double Divider = FMath::Max(InIterations, 1) / 1000000.0;
+		UE_LOG(LogMSynthesisBenchmark, Display, TEXT("Inventory Pawns=%d snapshot build %.2f us, bytes %llu"), InPawnCount, SnapshotSeconds * 1000000.0, static_cast<uint64>(Snapshot->GetAllocatedSize()));
+		UE_LOG(LogMSynthesisBenchmark, Display, TEXT("Inventory surplus : per-TID lookup %.2f us, columnar scan %.2f us"), LookupSeconds / Divider, ScanSeconds / Divider);
+	}
+
+	// 전체 합성 계획은 10k 보유 목록에서 수십 ms 안에 끝나야 한다.
+	constexpr double PlanBudgetMilliseconds = 50.0;
+
+	void RunPlannerBenchmark(const int InPawnCount, const int InIterations)
+	{
+		FData Data;
+		TArray<TPair<int, int>> Counts;
+
+		FRandomStream Stream(InPawnCount);
+		for (int TID = 1; TID <= InPawnCount; TID++)
+		{
+			Counts.Emplace(TID, Stream.RandRange(1, 6));
+		}
+
+		const TSharedRef<const FMPawnInventorySnapshot> Snapshot = FMPawnInventorySnapshot::Create(static_cast<EMPawnType>(0), Counts, nullptr, &Data);
+
+		double TotalSeconds = 0.0;
+		double MaxSeconds = 0.0;
+		FMSynthesisPlan Plan;
+		for (int Iteration = 0; Iteration < InIterations; Iteration++)
+		{
+			const double Start = FPlatformTime::Seconds();
+			Plan = FMSynthesisPlanner::Plan(*Snapshot, Data.Recipes, MaxSynthesisCount);
+			const double Seconds = FPlatformTime::Seconds() - Start;
+
+			TotalSeconds += Seconds;
+			MaxSeconds = FMath::Max(MaxSeconds, Seconds);
+		}
+
+		const double AverageMilliseconds = TotalSeconds * 1000.0 / FMath::Max(InIterations, 1);
+		UE_LOG(LogMSynthesisBenchmark, Display, TEXT("Plan Pawns=%d Steps=%d Rounds=%d TopGrade=%.2f : avg %.3f ms, max %.3f ms"),
+			InPawnCount, Plan.Steps.Num(), Plan.TotalRounds, Plan.ExpectedTopGradeCount, AverageMilliseconds, MaxSeconds * 1000.0);
+
+		if (MaxSeconds * 1000.0 > PlanBudgetMilliseconds)
+		{
+			UE_LOG(LogMSynthesisBenchmark, Warning, TEXT("Plan exceeded %.0f ms budget"), PlanBudgetMilliseconds);
+		}
+	}
+
+	// 기존 방식처럼 보유 목록 전체를 훑어 합성 가능한 등급이 있는지 본다.
+	bool ScanRedDot(const TMap<int, int>& InCounts, const FData& InData)
+	{
+		int SurplusByGrade[GradeCount] = {};
+		for (const TPair<int, int>& Pair : InCounts)
+		{
+			FMSynthesisPawnInfo Pawn;
+			if (InData.FindPawn(Pair.Key, Pawn))
+			{
+				SurplusByGrade[Pawn.Grade] += FMath::Max(Pair.Value - 1, 0);
+			}
+		}
+
+		for (const FMSynthesisRecipe& Recipe : InData.Recipes)
+		{
+			if (SurplusByGrade[Recipe.Grade] >= Recipe.MaterialCount)
+			{
+				return true;
+			}
+		}
+		return false;
+	}
+
+	void RunRedDotBenchmark(const int InPawnCount, const int InUpdates, const int InChangedPerUpdate)
+	{
+		FData Data;
+		TMap<int, int> Counts;
+		TArray<int> TIDs;
+		TArray<int> InitialCounts;
+
+		// 모두 1개씩 가진 상태에서 시작해야 레드닷이 켜지고 꺼지는 경계를 지난다.
+		for (int TID = 1; TID <= InPawnCount; TID++)
+		{
+			Counts.Emplace(TID, 1);
+			TIDs.Emplace(TID);
+			InitialCounts.Emplace(1);
+		}
+
+		FMSynthesisRedDotTracker Tracker;
+
+		double Start = FPlatformTime::Seconds();
+		Tracker.Rebuild(0, TIDs, InitialCounts, Data);
+		const double RebuildSeconds = FPlatformTime::Seconds() - Start;
+
+		FRandomStream Stream(InPawnCount);
+		TArray<TPair<int, int>> Changes;
+		double ScanSeconds = 0.0;
+		double IncrementalSeconds = 0.0;
+		int ScanFlips = 0;
+		int IncrementalFlips = 0;
+		int Mismatches = 0;
+		bool bScanRedDot = ScanRedDot(Counts, Data);
+
+		for (int Update = 0; Update < InUpdates; Update++)
+		{
+			// 합성 한번처럼 몇 TID를 소모하고 보상을 얻는다.
+			Changes.Reset();
+			for (int i = 0; i < InChangedPerUpdate; i++)
+			{
+				const int TID = Stream.RandRange(1, InPawnCount);
+				const int Count = Stream.RandRange(0, 2);
+				Counts.Emplace(TID, Count);
+				Changes.Emplace(TID, Count);
+			}
+
+			Start = FPlatformTime::Seconds();
+			const bool bScan = ScanRedDot(Counts, Data);
+			ScanSeconds += FPlatformTime::Seconds() - Start;
+			ScanFlips += bScan != bScanRedDot ? 1 : 0;
+			bScanRedDot = bScan;
+
+			Start = FPlatformTime::Seconds();
+			for (const TPair<int, int>& Change : Changes)
+			{
+				IncrementalFlips += Tracker.OnPawnCountChanged(Change.Key, Change.Value, Data) ? 1 : 0;
+			}
+			IncrementalSeconds += FPlatformTime::Seconds() - Start;
+
+			Mismatches += Tracker.HasRedDot(0) != bScan ? 1 : 0;
+		}
+
+		const double Divider = FMath::Max(InUpdates, 1) / 1000000.0;
+		UE_LOG(LogMSynthesisBenchmark, Display, TEXT("RedDot Pawns=%d Updates=%d Changed=%d Rebuild=%.2f us"), InPawnCount, InUpdates, InChangedPerUpdate, RebuildSeconds * 1000000.0);
+		UE_LOG(LogMSynthesisBenchmark, Display, TEXT("RedDot update : scan %.2f us, incremental %.2f us"), ScanSeconds / Divider, IncrementalSeconds / Divider);
+		UE_LOG(LogMSynthesisBenchmark, Display, TEXT("RedDot flips  : scan %d, incremental %d, mismatches %d"), ScanFlips, IncrementalFlips, Mismatches);
+	}
+}
+
+UMSynthesisBenchmarkCommandlet::UMSynthesisBenchmarkCommandlet()
+{
+	IsClient = false;
+	IsServer = false;
+	IsEditor = false;
+	LogToConsole = true;
+}
+
+int32 UMSynthesisBenchmarkCommandlet::Main(const FString& Params)
+{
+	using namespace MSynthesisBenchmark;
+
+	int PawnCount = 50000;
+	int Iterations = 100;
+	FParse::Value(*Params, TEXT("Pawns="), PawnCount);
+	FParse::Value(*Params, TEXT("Iterations="), Iterations);
+
+	FInventory Inventory;
+	FData Data;
+	TArray<int> Candidates;
+
+	FRandomStream Stream(PawnCount);
+	for (int TID = 1; TID <= PawnCount; TID++)
+	{
+		Inventory.Counts.Emplace(TID, Stream.RandRange(1, 6));
+		Candidates.Emplace(TID);
+	}
+
+	FMSynthesisModel Model;
+	Model.Initialize(&Inventory, &Data, FMSynthesisModel::DefaultSlotCount, MaxSynthesisCount);
+
+	TSet<int> Touched;
+	FMSynthesisIngredientList Ingredients;
+
+	double PushPopSeconds = 0.0;
+	double AutoSeconds = 0.0;
+	double BuildSeconds = 0.0;
+	int64 PushCount = 0;
+	int64 IngredientCount = 0;
+
+	for (int Iteration = 0; Iteration < Iterations; Iteration++)
+	{
+		Model.SetRecipe(Iteration % (GradeCount - 1) + 1);
+
+		double Start = FPlatformTime::Seconds();
+		for (const int TID : Candidates)
+		{
+			const int Index = Model.FindPossibleLeastCountSlotIndex();
+			if (Index < 0)
+			{
+				break;
+			}
+
+			PushCount += Model.Push(Index, TID) ? 1 : 0;
+		}
+		for (int i = 0; i < Model.GetSlotNum(); i++)
+		{
+			while (Model.Pop(i) > 0)
+			{
+			}
+		}
+		PushPopSeconds += FPlatformTime::Seconds() - Start;
+
+		Start = FPlatformTime::Seconds();
+		Model.AutoPush(Candidates);
+		AutoSeconds += FPlatformTime::Seconds() - Start;
+
+		Start = FPlatformTime::Seconds();
+		Ingredients.Reset();
+		IngredientCount += Model.BuildIngredients(Ingredients);
+		BuildSeconds += FPlatformTime::Seconds() - Start;
+
+		Model.Clear();
+		Model.MoveTouchedTIDs(Touched);
+		Touched.Reset();
+	}
+
+	const double Divider = FMath::Max(Iterations, 1) / 1000000.0;
+	UE_LOG(LogMSynthesisBenchmark, Display, TEXT("Pawns=%d Iterations=%d Pushed=%lld Synthesis=%lld"), PawnCount, Iterations, PushCount, IngredientCount);
+	UE_LOG(LogMSynthesisBenchmark, Display, TEXT("Push/Pop : %.2f us/iter"), PushPopSeconds / Divider);
+	UE_LOG(LogMSynthesisBenchmark, Display, TEXT("AutoPush : %.2f us/iter"), AutoSeconds / Divider);
+	UE_LOG(LogMSynthesisBenchmark, Display, TEXT("Build    : %.2f us/iter"), BuildSeconds / Divider);
+
+	int InventoryPawnCount = 10000;
+	FParse::Value(*Params, TEXT("InventoryPawns="), InventoryPawnCount);
+	RunInventoryScanBenchmark(InventoryPawnCount, Iterations);
+
+	int PlanPawnCount = 10000;
+	FParse::Value(*Params, TEXT("PlanPawns="), PlanPawnCount);
+	RunPlannerBenchmark(PlanPawnCount, Iterations);
+
+	int LookupCount = 1000000;
+	FParse::Value(*Params, TEXT("Lookups="), LookupCount);
+	for (const int RecordCount : { 10000, 100000 })
+	{
+		// 연속된 TID와 듬성듬성한 TID
+		RunLookupBenchmark(RecordCount, 1, LookupCount);
+		RunLookupBenchmark(RecordCount, 97, LookupCount);
+	}
+
+	int RedDotPawnCount = 10000;
+	int RedDotUpdates = 10000;
+	FParse::Value(*Params, TEXT("RedDotPawns="), RedDotPawnCount);
+	FParse::Value(*Params, TEXT("RedDotUpdates="), RedDotUpdates);
+	RunRedDotBenchmark(RedDotPawnCount, RedDotUpdates, MaterialCount + 1);
+
+	return 0;
+}
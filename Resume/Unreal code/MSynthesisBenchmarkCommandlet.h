@@ -0,0 +1,26 @@
+/***********************************************************************************
+ *                                                                                 *
+ * Copyright. (C) 2023 Mobirix.                                                    *
+ * Website: https://mobirix.com													   *
+ *                                                                                 *
+ ***********************************************************************************/
+
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Commandlets/Commandlet.h"
+#include "MSynthesisBenchmarkCommandlet.generated.h"
+
+// 합성 모델 벤치마크 커맨드렛. 가상 보유 목록으로 투입/회수/자동 투입/요청 구성, 보유 스냅샷 등급 집계, 전체 합성 계획, TID 조회 테이블, 합성 레드닷 갱신을 측정한다.
+// 예) -run=MSynthesisBenchmark -Pawns=50000 -Iterations=100 -InventoryPawns=10000 -PlanPawns=10000 -Lookups=1000000 -RedDotPawns=10000 -RedDotUpdates=10000
+UCLASS()
+class MRPG_API UMSynthesisBenchmarkCommandlet : public UCommandlet
+{
+	GENERATED_BODY()
+
+public:
+	UMSynthesisBenchmarkCommandlet();
+
+	virtual int32 Main(const FString& Params) override;
+};
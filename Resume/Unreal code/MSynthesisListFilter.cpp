@@ -0,0 +1,120 @@
+/***********************************************************************************
+ *                                                                                 *
+ * Copyright. (C) 2023 Mobirix.                                                    *
+ * Website: https://mobirix.com													   *
+ *                                                                                 *
+ ***********************************************************************************/
+
+
+#include "Synthesis/MSynthesisListFilter.h"
+
+#include "Data/Base/MdataStruct.h"
+#include "Synthesis/MPawnInventorySnapshot.h"
+
+void FMCachedListFilter::SetFilter(FFilterFunc&& InFilter, const EMListFilterDependency InDependency)
+{
+	Filter = MoveTemp(InFilter);
+	Dependency = InDependency;
+	Results.Reset();
+}
+
+bool FMCachedListFilter::Evaluate(const int InTID)
+{
+	if (const bool* Result = Results.Find(InTID))
+	{
+		return *Result;
+	}
+
+	const bool bResult = Filter ? Filter(InTID) : true;
+	Results.Emplace(InTID, bResult);
+
+	return bResult;
+}
+
+void FMCachedListFilter::Invalidate(const EMListFilterDependency InChanged, const int InTID)
+{
+	if (EnumHasAnyFlags(Dependency, InChanged))
+	{
+		Results.Remove(InTID);
+	}
+}
+
+void FMCachedListFilter::Invalidate(const EMListFilterDependency InChanged, const TArray<int>& InTIDs)
+{
+	if (EnumHasAnyFlags(Dependency, InChanged) == false)
+	{
+		return;
+	}
+
+	for (const int TID : InTIDs)
+	{
+		Results.Remove(TID);
+	}
+}
+
+void FMCachedListFilter::Reset()
+{
+	Results.Reset();
+}
+
+const TArray<int>& FMSynthesisGradeListIndex::GetTIDs(const FMPawnInventorySnapshot& InSnapshot, const int InGrade, FMCachedListFilter& InFilter)
+{
+	// 보유 수량 외의 입력에 의존하는 필터는 스냅샷 버전만으로 결과를 재사용할 수 없다.
+	check(EnumHasAnyFlags(InFilter.GetDependency(), ~EMListFilterDependency::Inventory) == false);
+
+	const int GradeNum = static_cast<int>(EMGrade::Legendary) + 1;
+
+	if (Version != InSnapshot.GetVersion() || TIDsByGrade.Num() != GradeNum + 1)
+	{
+		Version = InSnapshot.GetVersion();
+		TIDsByGrade.SetNum(GradeNum + 1);
+		Built.Init(false, GradeNum + 1);
+	}
+
+	const int Index = InGrade == INDEX_NONE ? 0 : FMath::Clamp(InGrade + 1, 1, GradeNum);
+
+	TArray<int>& TIDs = TIDsByGrade[Index];
+	if (Built[Index])
+	{
+		return TIDs;
+	}
+
+	int Begin = 0;
+	int End = InSnapshot.Num();
+	if (Index > 0)
+	{
+		InSnapshot.GetGradeRange(static_cast<EMGrade>(Index - 1), Begin, End);
+	}
+
+	const TArray<int>& SnapshotTIDs = InSnapshot.GetTIDs();
+
+	TIDs.Reset();
+	for (int i = Begin; i < End; i++)
+	{
+		if (InFilter.Evaluate(SnapshotTIDs[i]))
+		{
+			TIDs.Emplace(SnapshotTIDs[i]);
+		}
+	}
+
+	Built[Index] = true;
+
+	return TIDs;
+}
+
+void FMSynthesisGradeListIndex::Reset()
+{
+	Version = 0;
+	TIDsByGrade.Reset();
+	Built.Empty();
+}
+
+SIZE_T FMSynthesisGradeListIndex::GetAllocatedSize() const
+{
+	SIZE_T Size = TIDsByGrade.GetAllocatedSize() + Built.GetAllocatedSize();
+	for (const TArray<int>& TIDs : TIDsByGrade)
+	{
+		Size += TIDs.GetAllocatedSize();
+	}
+	return Size;
+}
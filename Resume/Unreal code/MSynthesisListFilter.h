@@ -0,0 +1,73 @@
+/***********************************************************************************
+ *                                                                                 *
+ * Copyright. (C) 2023 Mobirix.                                                    *
+ * Website: https://mobirix.com													   *
+ *                                                                                 *
+ ***********************************************************************************/
+
+
+#pragma once
+
+#include "CoreMinimal.h"
+
+struct FMPawnInventorySnapshot;
+
+// 목록 필터가 결과를 계산할 때 읽는 입력
+enum class EMListFilterDependency : uint8
+{
+	None		= 0,
+	Inventory	= 1 << 0,	// 보유 수량
+	Ingredient	= 1 << 1,	// 합성 슬롯에 투입된 수량
+};
+ENUM_CLASS_FLAGS(EMListFilterDependency);
+
+// TID별 필터 결과를 기억해두고, 선언한 입력이 바뀐 TID만 다시 계산한다.
+class MRPG_API FMCachedListFilter
+{
+public:
+	using FFilterFunc = TFunction<bool(const int)>;
+
+	void SetFilter(FFilterFunc&& InFilter, const EMListFilterDependency InDependency);
+
+	bool Evaluate(const int InTID);
+
+	void Invalidate(const EMListFilterDependency InChanged, const int InTID);
+
+	void Invalidate(const EMListFilterDependency InChanged, const TArray<int>& InTIDs);
+
+	void Reset();
+
+	EMListFilterDependency GetDependency() const { return Dependency; }
+
+	int GetCachedCount() const { return Results.Num(); }
+
+	SIZE_T GetAllocatedSize() const { return Results.GetAllocatedSize(); }
+
+private:
+	FFilterFunc Filter;
+
+	EMListFilterDependency Dependency = EMListFilterDependency::None;
+
+	TMap<int, bool> Results;
+};
+
+// 스냅샷의 등급 -> TID 정렬을 그대로 이용한 등급별 목록 인덱스.
+// 보유 수량에만 의존하는 필터를 받으며, 스냅샷 버전이 같으면 등급 탭을 바꿔도 다시 만들지 않는다.
+class MRPG_API FMSynthesisGradeListIndex
+{
+public:
+	// InGrade가 INDEX_NONE이면 전체 등급
+	const TArray<int>& GetTIDs(const FMPawnInventorySnapshot& InSnapshot, const int InGrade, FMCachedListFilter& InFilter);
+
+	void Reset();
+
+	SIZE_T GetAllocatedSize() const;
+
+private:
+	uint32 Version = 0;
+
+	// 0번은 전체 등급, 나머지는 등급 값 + 1
+	TArray<TArray<int>> TIDsByGrade;
+
+	TBitArray<> Built;
+};
@@ -0,0 +1,303 @@
+/***********************************************************************************
+ *                                                                                 *
+ * Copyright. (C) 2023 Mobirix.                                                    *
+ * Website: https://mobirix.com													   *
+ *                                                                                 *
+ ***********************************************************************************/
+
+
+#include "Synthesis/MSynthesisModel.h"
+
+void FMSynthesisModel::Initialize(const IMSynthesisInventoryProvider* InInventory, const IMSynthesisDataProvider* InData, const int InSlotNum, const int InMaxSynthesisCount)
+{
+	Inventory = InInventory;
+	Data = InData;
+	MaxSynthesisCount = InMaxSynthesisCount;
+	Recipe = FMSynthesisRecipe();
+
+	Slots.Reset();
+	Slots.SetNum(InSlotNum);
+	CountMap.Reset();
+	TouchedTIDs.Reset();
+}
+
+void FMSynthesisModel::SetRecipe(const int InSynthesisTID)
+{
+	const FMSynthesisRecipe* Found = Data ? Data->FindRecipe(InSynthesisTID) : nullptr;
+	Recipe = Found ? *Found : FMSynthesisRecipe();
+}
+
+const FMSynthesisRecipe* FMSynthesisModel::GetRecipe() const
+{
+	return Recipe.SynthesisTID > 0 ? &Recipe : nullptr;
+}
+
+bool FMSynthesisModel::CanPush(const int InIndex, const int InTID) const
+{
+	if (Slots.IsValidIndex(InIndex) == false || Inventory == nullptr || Data == nullptr)
+	{
+		return false;
+	}
+
+	if (IsSlotFull(InIndex))
+	{
+		return false;
+	}
+
+	FMSynthesisPawnInfo Pawn;
+	if (Data->FindPawn(InTID, Pawn) == false)
+	{
+		return false;
+	}
+
+	if (const FMSynthesisRecipe* Current = GetRecipe())
+	{
+		if (Pawn.PawnType != Current->PawnType ||
+			Pawn.Grade != Current->Grade)
+		{
+			return false;
+		}
+
+		return Inventory->GetHaveCount(InTID) - GetIngredientCountOfTID(InTID) > 1;
+	}
+
+	if (Data->FindRecipeOfPawn(Pawn))
+	{
+		return Inventory->GetHaveCount(InTID) > 1;
+	}
+
+	return false;
+}
+
+bool FMSynthesisModel::Push(const int InIndex, const int InTID)
+{
+	if (CanPush(InIndex, InTID) == false)
+	{
+		return false;
+	}
+
+	if (GetRecipe() == nullptr)
+	{
+		FMSynthesisPawnInfo Pawn;
+		if (Data->FindPawn(InTID, Pawn))
+		{
+			if (const FMSynthesisRecipe* Found = Data->FindRecipeOfPawn(Pawn))
+			{
+				Recipe = *Found;
+			}
+		}
+	}
+
+	Slots[InIndex].Emplace(InTID);
+	CountMap.FindOrAdd(InTID)++;
+	TouchedTIDs.Emplace(InTID);
+
+	return true;
+}
+
+int FMSynthesisModel::Pop(const int InIndex)
+{
+	if (Slots.IsValidIndex(InIndex) == false || Slots[InIndex].Num() <= 0)
+	{
+		return 0;
+	}
+
+	const int TID = Slots[InIndex].Last();
+	Slots[InIndex].RemoveAt(Slots[InIndex].Num() - 1);
+	if (int* Count = CountMap.Find(TID))
+	{
+		if (--(*Count) <= 0)
+		{
+			CountMap.Remove(TID);
+		}
+	}
+	TouchedTIDs.Emplace(TID);
+
+	return TID;
+}
+
+void FMSynthesisModel::Clear()
+{
+	for (const TPair<int, int>& Pair : CountMap)
+	{
+		TouchedTIDs.Emplace(Pair.Key);
+	}
+
+	CountMap.Reset();
+
+	for (TArray<int>& Slot : Slots)
+	{
+		Slot.Reset();
+	}
+}
+
+void FMSynthesisModel::AutoPush(const TArray<int>& InCandidates)
+{
+	const FMSynthesisRecipe* Current = GetRecipe();
+	if (Current == nullptr || Data == nullptr)
+	{
+		return;
+	}
+
+	for (int i = InCandidates.Num() - 1; InCandidates.IsValidIndex(i); i--)
+	{
+		const int PawnTID = InCandidates[i];
+
+		FMSynthesisPawnInfo Pawn;
+		if (Data->FindPawn(PawnTID, Pawn) == false)
+		{
+			continue;
+		}
+
+		if (Pawn.Grade != Current->Grade)
+		{
+			continue;
+		}
+
+		while (true)
+		{
+			const int Index = FindPossibleLeastCountSlotIndex();
+			if (Slots.IsValidIndex(Index) == false)
+			{
+				break;
+			}
+
+			if (Push(Index, PawnTID) == false)
+			{
+				break;
+			}
+		}
+
+		if (Slots.IsValidIndex(FindPossibleLeastCountSlotIndex()) == false)
+		{
+			break;
+		}
+	}
+
+	const int SlotCount = FMath::Min(GetSlotCount(), Slots.Num());
+	const int Min = GetCurrentSynthesisCount();
+
+	for (int i = 0; i < SlotCount; i++)
+	{
+		while (Slots[i].Num() > Min)
+		{
+			Pop(i);
+		}
+	}
+}
+
+int FMSynthesisModel::BuildIngredients(FMSynthesisIngredientList& OutIngredients) const
+{
+	const int SynthesisCount = GetCurrentSynthesisCount();
+	for (const TArray<int>& Slot : Slots)
+	{
+		for (int i = 0; i < Slot.Num() && i < SynthesisCount; i++)
+		{
+			AddIngredient(OutIngredients, Slot[i], 1);
+		}
+	}
+
+	return SynthesisCount;
+}
+
+void FMSynthesisModel::AddIngredient(FMSynthesisIngredientList& OutIngredients, const int InTID, const int InCount)
+{
+	for (TPair<int, int>& Pair : OutIngredients)
+	{
+		if (Pair.Key == InTID)
+		{
+			Pair.Value += InCount;
+			return;
+		}
+	}
+
+	OutIngredients.Emplace(InTID, InCount);
+}
+
+bool FMSynthesisModel::IsSlotFull(const int InIndex) const
+{
+	if (Slots.IsValidIndex(InIndex) == false)
+	{
+		return false;
+	}
+
+	return Slots[InIndex].Num() >= MaxSynthesisCount;
+}
+
+int FMSynthesisModel::GetIngredientCountOfTID(const int InTID) const
+{
+	const int* Count = CountMap.Find(InTID);
+	return Count ? *Count : 0;
+}
+
+int FMSynthesisModel::GetIngredientCount(const int InIndex) const
+{
+	if (Slots.IsValidIndex(InIndex))
+	{
+		return Slots[InIndex].Num();
+	}
+	return -1;
+}
+
+const TArray<int>& FMSynthesisModel::GetIngredients(const int InIndex) const
+{
+	static const TArray<int> Empty;
+	return Slots.IsValidIndex(InIndex) ? Slots[InIndex] : Empty;
+}
+
+int FMSynthesisModel::GetSlotCount() const
+{
+	if (const FMSynthesisRecipe* Current = GetRecipe())
+	{
+		return Current->MaterialCount;
+	}
+
+	return DefaultSlotCount;	// 아무런 재료 투입이 안되어있으면 4개 슬롯 표시
+}
+
+int FMSynthesisModel::FindPossibleLeastCountSlotIndex() const
+{
+	int Index = -1;
+	int MinCount = MaxSynthesisCount;
+
+	for (int i = 0; i < GetSlotCount() && i < Slots.Num(); i++)
+	{
+		if (Slots[i].Num() < MinCount)
+		{
+			Index = i;
+			MinCount = Slots[i].Num();
+		}
+	}
+
+	return Index;
+}
+
+int FMSynthesisModel::GetCurrentSynthesisCount() const
+{
+	int MinCount = MaxSynthesisCount;
+	for (int i = 0; i < GetSlotCount() && i < Slots.Num(); i++)
+	{
+		if (Slots[i].Num() < MinCount)
+		{
+			MinCount = Slots[i].Num();
+		}
+	}
+
+	return MinCount;
+}
+
+void FMSynthesisModel::MoveTouchedTIDs(TSet<int>& OutTIDs)
+{
+	OutTIDs.Append(TouchedTIDs);
+	TouchedTIDs.Reset();
+}
+
+SIZE_T FMSynthesisModel::GetAllocatedSize() const
+{
+	SIZE_T Size = Slots.GetAllocatedSize() + CountMap.GetAllocatedSize() + TouchedTIDs.GetAllocatedSize();
+	for (const TArray<int>& Slot : Slots)
+	{
+		Size += Slot.GetAllocatedSize();
+	}
+	return Size;
+}
@@ -0,0 +1,109 @@
+/***********************************************************************************
+ *                                                                                 *
+ * Copyright. (C) 2023 Mobirix.                                                    *
+ * Website: https://mobirix.com													   *
+ *                                                                                 *
+ ***********************************************************************************/
+
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Synthesis/MSynthesisPlanner.h"
+
+// 한 요청의 재료 종류는 슬롯 수 x 최대 합성 횟수를 넘지 않으므로 힙 할당 없이 담는다.
+using FMSynthesisIngredientList = TArray<TPair<int, int>, TInlineAllocator<44>>;
+
+struct MRPG_API FMSynthesisPawnInfo
+{
+	int PawnType = 0;
+
+	int Grade = 0;
+};
+
+class MRPG_API IMSynthesisInventoryProvider
+{
+public:
+	virtual ~IMSynthesisInventoryProvider() = default;
+
+	virtual int GetHaveCount(const int InTID) const = 0;
+};
+
+class MRPG_API IMSynthesisDataProvider
+{
+public:
+	virtual ~IMSynthesisDataProvider() = default;
+
+	virtual bool FindPawn(const int InTID, FMSynthesisPawnInfo& OutPawn) const = 0;
+
+	virtual const FMSynthesisRecipe* FindRecipe(const int InSynthesisTID) const = 0;
+
+	virtual const FMSynthesisRecipe* FindRecipeOfPawn(const FMSynthesisPawnInfo& InPawn) const = 0;
+};
+
+// 합성 슬롯 규칙만 담은 모델. 위젯이나 UObject에 의존하지 않고 주입된 보유 수량/데이터로만 동작한다.
+class MRPG_API FMSynthesisModel
+{
+public:
+	static constexpr int DefaultSlotCount = 4;
+
+	void Initialize(const IMSynthesisInventoryProvider* InInventory, const IMSynthesisDataProvider* InData, const int InSlotNum, const int InMaxSynthesisCount);
+
+	void SetRecipe(const int InSynthesisTID);
+
+	const FMSynthesisRecipe* GetRecipe() const;
+
+	bool CanPush(const int InIndex, const int InTID) const;
+
+	bool Push(const int InIndex, const int InTID);
+
+	int Pop(const int InIndex);
+
+	void Clear();
+
+	// 후보 목록의 뒤에서부터 채우고, 슬롯별 재료 수를 가장 적은 슬롯에 맞춘다.
+	void AutoPush(const TArray<int>& InCandidates);
+
+	// 합성 요청에 실을 재료를 TID별로 모은다. 반환값은 합성 횟수
+	int BuildIngredients(FMSynthesisIngredientList& OutIngredients) const;
+
+	static void AddIngredient(FMSynthesisIngredientList& OutIngredients, const int InTID, const int InCount);
+
+	bool IsSlotFull(const int InIndex) const;
+
+	int GetIngredientCountOfTID(const int InTID) const;
+
+	int GetIngredientCount(const int InIndex) const;
+
+	const TArray<int>& GetIngredients(const int InIndex) const;
+
+	int GetSlotNum() const { return Slots.Num(); }
+
+	int GetSlotCount() const;
+
+	int FindPossibleLeastCountSlotIndex() const;
+
+	int GetCurrentSynthesisCount() const;
+
+	int GetMaxSynthesisCount() const { return MaxSynthesisCount; }
+
+	// 마지막 호출 이후 투입 수량이 바뀐 TID를 넘겨준다.
+	void MoveTouchedTIDs(TSet<int>& OutTIDs);
+
+	SIZE_T GetAllocatedSize() const;
+
+private:
+	const IMSynthesisInventoryProvider* Inventory = nullptr;
+
+	const IMSynthesisDataProvider* Data = nullptr;
+
+	FMSynthesisRecipe Recipe;
+
+	int MaxSynthesisCount = 0;
+
+	TArray<TArray<int>> Slots;
+
+	TMap<int, int> CountMap;
+
+	TSet<int> TouchedTIDs;
+};
@@ -0,0 +1,214 @@
+/***********************************************************************************
+ *                                                                                 *
+ * Copyright. (C) 2023 Mobirix.                                                    *
+ * Website: https://mobirix.com													   *
+ *                                                                                 *
+ ***********************************************************************************/
+
+
+#include "Misc/AutomationTest.h"
+#include "Synthesis/MSynthesisModel.h"
+
+#if WITH_DEV_AUTOMATION_TESTS
+
+namespace MSynthesisModelTests
+{
+	constexpr int MaxSynthesisCount = 11;
+
+	// 10번대 TID는 0등급, 20번대 TID는 1등급
+	constexpr int CommonRecipeTID = 1;
+	constexpr int UncommonRecipeTID = 2;
+
+	class FFakeInventory : public IMSynthesisInventoryProvider
+	{
+	public:
+		virtual int GetHaveCount(const int InTID) const override
+		{
+			const int* Count = Counts.Find(InTID);
+			return Count ? *Count : 0;
+		}
+
+		TMap<int, int> Counts;
+	};
+
+	class FFakeData : public IMSynthesisDataProvider
+	{
+	public:
+		FFakeData()
+		{
+			FMSynthesisRecipe& Common = Recipes.AddDefaulted_GetRef();
+			Common.SynthesisTID = CommonRecipeTID;
+			Common.Grade = 0;
+			Common.MaterialCount = 4;
+
+			FMSynthesisRecipe& Uncommon = Recipes.AddDefaulted_GetRef();
+			Uncommon.SynthesisTID = UncommonRecipeTID;
+			Uncommon.Grade = 1;
+			Uncommon.MaterialCount = 3;
+		}
+
+		virtual bool FindPawn(const int InTID, FMSynthesisPawnInfo& OutPawn) const override
+		{
+			if (InTID < 10 || InTID >= 30)
+			{
+				return false;
+			}
+
+			OutPawn.PawnType = 0;
+			OutPawn.Grade = InTID / 10 - 1;
+			return true;
+		}
+
+		virtual const FMSynthesisRecipe* FindRecipe(const int InSynthesisTID) const override
+		{
+			return Recipes.IsValidIndex(InSynthesisTID - 1) ? &Recipes[InSynthesisTID - 1] : nullptr;
+		}
+
+		virtual const FMSynthesisRecipe* FindRecipeOfPawn(const FMSynthesisPawnInfo& InPawn) const override
+		{
+			return Recipes.IsValidIndex(InPawn.Grade) ? &Recipes[InPawn.Grade] : nullptr;
+		}
+
+		TArray<FMSynthesisRecipe> Recipes;
+	};
+
+	int FindIngredientCount(const FMSynthesisIngredientList& InIngredients, const int InTID)
+	{
+		for (const TPair<int, int>& Pair : InIngredients)
+		{
+			if (Pair.Key == InTID)
+			{
+				return Pair.Value;
+			}
+		}
+		return 0;
+	}
+}
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FMSynthesisModelPushPopTest, "MRPG.Synthesis.Model.PushPop", EAutomationTestFlags::ApplicationContextMask | EAutomationTestFlags::ProductFilter)
+
+bool FMSynthesisModelPushPopTest::RunTest(const FString& Parameters)
+{
+	using namespace MSynthesisModelTests;
+
+	FFakeInventory Inventory;
+	FFakeData Data;
+	Inventory.Counts.Emplace(10, 3);
+	Inventory.Counts.Emplace(20, 5);
+
+	FMSynthesisModel Model;
+	Model.Initialize(&Inventory, &Data, FMSynthesisModel::DefaultSlotCount, MaxSynthesisCount);
+
+	TestFalse(TEXT("Unknown pawn is rejected"), Model.Push(0, 99));
+	TestTrue(TEXT("First push"), Model.Push(0, 10));
+	TestTrue(TEXT("Recipe is picked from the first pawn"), Model.GetRecipe() && Model.GetRecipe()->SynthesisTID == CommonRecipeTID);
+	TestTrue(TEXT("Second push"), Model.Push(1, 10));
+	TestFalse(TEXT("Last one of a TID is kept"), Model.Push(2, 10));
+	TestFalse(TEXT("Other grade is rejected"), Model.Push(2, 20));
+
+	TestEqual(TEXT("Slot 0 count"), Model.GetIngredientCount(0), 1);
+	TestEqual(TEXT("Slot 1 count"), Model.GetIngredientCount(1), 1);
+	TestEqual(TEXT("Slot 2 count"), Model.GetIngredientCount(2), 0);
+	TestEqual(TEXT("TID count after push"), Model.GetIngredientCountOfTID(10), 2);
+
+	TestEqual(TEXT("Pop returns the TID"), Model.Pop(0), 10);
+	TestEqual(TEXT("Pop of an empty slot"), Model.Pop(0), 0);
+	TestEqual(TEXT("TID count after pop"), Model.GetIngredientCountOfTID(10), 1);
+	TestEqual(TEXT("Slot 1 is untouched"), Model.GetIngredients(1).Num(), 1);
+
+	TSet<int> Touched;
+	Model.MoveTouchedTIDs(Touched);
+	TestTrue(TEXT("Touched TIDs"), Touched.Num() == 1 && Touched.Contains(10));
+
+	Model.Clear();
+	TestEqual(TEXT("TID count after clear"), Model.GetIngredientCountOfTID(10), 0);
+	TestEqual(TEXT("Slot 1 after clear"), Model.GetIngredientCount(1), 0);
+
+	return true;
+}
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FMSynthesisModelAutoPushTest, "MRPG.Synthesis.Model.AutoPush", EAutomationTestFlags::ApplicationContextMask | EAutomationTestFlags::ProductFilter)
+
+bool FMSynthesisModelAutoPushTest::RunTest(const FString& Parameters)
+{
+	using namespace MSynthesisModelTests;
+
+	FFakeInventory Inventory;
+	FFakeData Data;
+	Inventory.Counts.Emplace(10, 5);
+	Inventory.Counts.Emplace(11, 9);
+	Inventory.Counts.Emplace(20, 10);
+
+	FMSynthesisModel Model;
+	Model.Initialize(&Inventory, &Data, FMSynthesisModel::DefaultSlotCount, MaxSynthesisCount);
+
+	// 레시피가 없으면 아무것도 넣지 않는다.
+	Model.AutoPush({ 20, 10, 11 });
+	TestEqual(TEXT("No recipe, no push"), Model.GetIngredientCountOfTID(11), 0);
+
+	// 뒤에서부터 11의 나머지 8개, 10의 나머지 4개를 넣어 4슬롯 x 3회가 된다. 다른 등급인 20은 넣지 않는다.
+	Model.SetRecipe(CommonRecipeTID);
+	Model.AutoPush({ 20, 10, 11 });
+
+	TestEqual(TEXT("Synthesis count"), Model.GetCurrentSynthesisCount(), 3);
+	TestEqual(TEXT("TID 11"), Model.GetIngredientCountOfTID(11), 8);
+	TestEqual(TEXT("TID 10"), Model.GetIngredientCountOfTID(10), 4);
+	TestEqual(TEXT("TID 20"), Model.GetIngredientCountOfTID(20), 0);
+
+	for (int i = 0; i < Model.GetSlotCount(); i++)
+	{
+		TestEqual(FString::Printf(TEXT("Slot %d"), i), Model.GetIngredientCount(i), 3);
+	}
+
+	// 남는 재료가 슬롯마다 고르지 않으면 가장 적은 슬롯에 맞춰 덜어낸다.
+	Model.Clear();
+	Inventory.Counts.Emplace(11, 7);
+	Model.AutoPush({ 11 });
+
+	TestEqual(TEXT("Trimmed synthesis count"), Model.GetCurrentSynthesisCount(), 1);
+	TestEqual(TEXT("Trimmed TID 11"), Model.GetIngredientCountOfTID(11), 4);
+
+	return true;
+}
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FMSynthesisModelBuildTest, "MRPG.Synthesis.Model.BuildIngredients", EAutomationTestFlags::ApplicationContextMask | EAutomationTestFlags::ProductFilter)
+
+bool FMSynthesisModelBuildTest::RunTest(const FString& Parameters)
+{
+	using namespace MSynthesisModelTests;
+
+	FFakeInventory Inventory;
+	FFakeData Data;
+	Inventory.Counts.Emplace(10, 5);
+	Inventory.Counts.Emplace(11, 5);
+
+	FMSynthesisModel Model;
+	Model.Initialize(&Inventory, &Data, FMSynthesisModel::DefaultSlotCount, MaxSynthesisCount);
+
+	// 슬롯별 재료 수 2, 2, 2, 1
+	Model.Push(0, 10);
+	Model.Push(0, 10);
+	Model.Push(1, 10);
+	Model.Push(1, 11);
+	Model.Push(2, 11);
+	Model.Push(2, 11);
+	Model.Push(3, 10);
+
+	FMSynthesisIngredientList Ingredients;
+	TestEqual(TEXT("Synthesis count is the smallest slot"), Model.BuildIngredients(Ingredients), 1);
+	TestEqual(TEXT("Ingredient kinds"), Ingredients.Num(), 2);
+	TestEqual(TEXT("TID 10"), FindIngredientCount(Ingredients, 10), 3);
+	TestEqual(TEXT("TID 11"), FindIngredientCount(Ingredients, 11), 1);
+
+	// 나머지 슬롯을 채우면 두 번 분량이 실린다.
+	Model.Push(3, 11);
+
+	Ingredients.Reset();
+	TestEqual(TEXT("Synthesis count after fill"), Model.BuildIngredients(Ingredients), 2);
+	TestEqual(TEXT("TID 10 after fill"), FindIngredientCount(Ingredients, 10), 4);
+	TestEqual(TEXT("TID 11 after fill"), FindIngredientCount(Ingredients, 11), 4);
+
+	return true;
+}
+
+#endif
@@ -0,0 +1,121 @@
+/***********************************************************************************
+ *                                                                                 *
+ * Copyright. (C) 2023 Mobirix.                                                    *
+ * Website: https://mobirix.com													   *
+ *                                                                                 *
+ ***********************************************************************************/
+
+
+#include "Synthesis/MSynthesisPlanner.h"
+
+#include "Async/Async.h"
+#include "Data/Base/MdataStruct.h"
+#include "Synthesis/MPawnInventorySnapshot.h"
+
+FMSynthesisRecipe FMSynthesisRecipe::FromData(const int InSynthesisTID, const FMSynthesisData& InData)
+{
+	FMSynthesisRecipe Recipe;
+	Recipe.SynthesisTID = InSynthesisTID;
+	Recipe.PawnType = static_cast<int>(InData.PawnType);
+	Recipe.Grade = static_cast<int>(InData.Grade);
+	Recipe.MaterialCount = InData.MaterialCount;
+	// UpgradeProb는 만분율
+	Recipe.UpgradeRate = FMath::Clamp(InData.UpgradeProb / 10000.0, 0.0, 1.0);
+	return Recipe;
+}
+
+FMSynthesisPlan FMSynthesisPlanner::Plan(const FMPawnInventorySnapshot& InSnapshot, TArray<FMSynthesisRecipe> InRecipes, const int InMaxSynthesisCount)
+{
+	FMSynthesisPlan Plan;
+	Plan.InventoryVersion = InSnapshot.GetVersion();
+
+	InRecipes.RemoveAll([ ] (const FMSynthesisRecipe& Recipe)
+	{
+		return Recipe.MaterialCount <= 0;
+	});
+
+	InRecipes.Sort([ ] (const FMSynthesisRecipe& A, const FMSynthesisRecipe& B)
+	{
+		return A.Grade < B.Grade;
+	});
+
+	int TopGrade = 0;
+	for (const FMSynthesisRecipe& Recipe : InRecipes)
+	{
+		TopGrade = FMath::Max(TopGrade, Recipe.Grade + 1);
+	}
+	Plan.ExpectedGainByGrade.Init(0.0, TopGrade + 1);
+
+	const TArray<int>& TIDs = InSnapshot.GetTIDs();
+	const TArray<int>& Counts = InSnapshot.GetCounts();
+
+	TArray<int> SurplusByGrade;
+	InSnapshot.GetSurplusByGrade(SurplusByGrade);
+
+	for (const FMSynthesisRecipe& Recipe : InRecipes)
+	{
+		const int OwnedSurplus = SurplusByGrade.IsValidIndex(Recipe.Grade) ? SurplusByGrade[Recipe.Grade] : 0;
+
+		// 하위 등급 합성으로 얻을 것으로 기대되는 수량도 재료로 쓴다.
+		const double CarriedIn = Plan.ExpectedGainByGrade[Recipe.Grade];
+
+		FMSynthesisPlanStep Step;
+		Step.SynthesisTID = Recipe.SynthesisTID;
+		Step.Grade = Recipe.Grade;
+		Step.Rounds = OwnedSurplus / Recipe.MaterialCount;
+		Step.ExpectedRounds = FMath::FloorToDouble((OwnedSurplus + CarriedIn) / Recipe.MaterialCount);
+		Step.ExpectedUpgrades = Step.ExpectedRounds * Recipe.UpgradeRate;
+
+		if (Step.ExpectedRounds <= 0.0)
+		{
+			continue;
+		}
+
+		Plan.ExpectedGainByGrade[Recipe.Grade] -= FMath::Min(CarriedIn, Step.ExpectedRounds * Recipe.MaterialCount);
+		Plan.ExpectedGainByGrade[Recipe.Grade + 1] += Step.ExpectedUpgrades;
+
+		if (Step.Rounds > 0)
+		{
+			Step.RequestCount = InMaxSynthesisCount > 0 ? FMath::DivideAndRoundUp(Step.Rounds, InMaxSynthesisCount) : 1;
+
+			int Begin, End;
+			InSnapshot.GetGradeRange(static_cast<EMGrade>(Recipe.Grade), Begin, End);
+
+			int Need = Step.Rounds * Recipe.MaterialCount;
+			for (int i = Begin; i < End && Need > 0; i++)
+			{
+				if (Counts[i] <= 1)
+				{
+					continue;
+				}
+
+				const int Take = FMath::Min(Need, Counts[i] - 1);
+				Step.Ingredients.Emplace(TIDs[i], Take);
+				Need -= Take;
+			}
+		}
+
+		Plan.TotalRounds += Step.Rounds;
+		Plan.Steps.Emplace(MoveTemp(Step));
+	}
+
+	Plan.ExpectedTopGradeCount = Plan.ExpectedGainByGrade.Num() > 0 ? Plan.ExpectedGainByGrade.Last() : 0.0;
+
+	return Plan;
+}
+
+void FMSynthesisPlanner::PlanAsync(const TSharedRef<const FMPawnInventorySnapshot>& InSnapshot, TArray<FMSynthesisRecipe> InRecipes, const int InMaxSynthesisCount, TFunction<void(FMSynthesisPlan&&)> InOnCompleted)
+{
+	Async(EAsyncExecution::ThreadPool, [ InSnapshot, Recipes = MoveTemp(InRecipes), InMaxSynthesisCount, OnCompleted = MoveTemp(InOnCompleted) ] () mutable
+	{
+		FMSynthesisPlan Result = FMSynthesisPlanner::Plan(*InSnapshot, MoveTemp(Recipes), InMaxSynthesisCount);
+
+		AsyncTask(ENamedThreads::GameThread, [ Result = MoveTemp(Result), OnCompleted = MoveTemp(OnCompleted) ] () mutable
+		{
+			if (OnCompleted)
+			{
+				OnCompleted(MoveTemp(Result));
+			}
+		});
+	});
+}
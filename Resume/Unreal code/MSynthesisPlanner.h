@@ -0,0 +1,77 @@
+/***********************************************************************************
+ *                                                                                 *
+ * Copyright. (C) 2023 Mobirix.                                                    *
+ * Website: https://mobirix.com													   *
+ *                                                                                 *
+ ***********************************************************************************/
+
+
+#pragma once
+
+#include "CoreMinimal.h"
+
+struct FMPawnInventorySnapshot;
+struct FMSynthesisData;
+
+// 합성 계획에 필요한 합성 데이터 사본. 게임 스레드 밖에서 데이터 매니저를 읽지 않도록 미리 복사해 둔다.
+struct MRPG_API FMSynthesisRecipe
+{
+	// 베이크된 테이블의 레코드 구조 버전. 멤버가 바뀌면 올린다.
+	static constexpr uint32 BakedSchemaVersion = 1;
+
+	int SynthesisTID = 0;
+
+	int PawnType = 0;
+
+	int Grade = 0;
+
+	int MaterialCount = 0;
+
+	double UpgradeRate = 0.0;
+
+	static FMSynthesisRecipe FromData(const int InSynthesisTID, const FMSynthesisData& InData);
+};
+
+struct MRPG_API FMSynthesisPlanStep
+{
+	int SynthesisTID = 0;
+
+	int Grade = 0;
+
+	// 현재 보유한 재료만으로 확정된 합성 횟수와 재료
+	int Rounds = 0;
+
+	int RequestCount = 0;
+
+	TArray<TPair<int, int>> Ingredients;
+
+	// 하위 등급 합성 결과까지 포함한 기대 합성 횟수와 상위 등급 획득 기대값
+	double ExpectedRounds = 0.0;
+
+	double ExpectedUpgrades = 0.0;
+};
+
+struct MRPG_API FMSynthesisPlan
+{
+	uint32 InventoryVersion = 0;
+
+	TArray<FMSynthesisPlanStep> Steps;
+
+	// 등급별 획득 기대값. 인덱스는 등급 값
+	TArray<double> ExpectedGainByGrade;
+
+	int TotalRounds = 0;
+
+	double ExpectedTopGradeCount = 0.0;
+};
+
+// 낮은 등급부터 상위 등급으로 이어지는 전체 합성 계획을 세운다.
+// 각 TID는 1개씩 남기고, 실패 시 돌려받는 보상은 기대값에 넣지 않는다.
+class MRPG_API FMSynthesisPlanner
+{
+public:
+	static FMSynthesisPlan Plan(const FMPawnInventorySnapshot& InSnapshot, TArray<FMSynthesisRecipe> InRecipes, const int InMaxSynthesisCount);
+
+	// 워커 스레드에서 계획을 세우고 결과는 게임 스레드에서 전달한다.
+	static void PlanAsync(const TSharedRef<const FMPawnInventorySnapshot>& InSnapshot, TArray<FMSynthesisRecipe> InRecipes, const int InMaxSynthesisCount, TFunction<void(FMSynthesisPlan&&)> InOnCompleted);
+};
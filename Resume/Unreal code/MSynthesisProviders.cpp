@@ -0,0 +1,174 @@
+/***********************************************************************************
+ *                                                                                 *
+ * Copyright. (C) 2023 Mobirix.                                                    *
+ * Website: https://mobirix.com													   *
+ *                                                                                 *
+ ***********************************************************************************/
+
+
+#include "Synthesis/MSynthesisProviders.h"
+
+#include "Data/MBakedTable.h"
+#include "Data/MDataManager.h"
+#include "Data/Base/MdataStruct.h"
+#include "HAL/IConsoleManager.h"
+#include "Misc/Paths.h"
+#include "Network/Data/MNetworkDataManager.h"
+#include "Synthesis/MPawnInventorySnapshot.h"
+
+DEFINE_LOG_CATEGORY_STATIC(LogMSynthesisProvider, Log, All);
+
+namespace MSynthesisProvider
+{
+	// 베이크 파일에는 원본 데이터와 맞는지 확인할 값이 없다. 데이터와 함께 굽는 빌드에서만 켠다.
+	int32 UseBakedRecipes = 0;
+	FAutoConsoleVariableRef CVarUseBakedRecipes(TEXT("MSynthesis.BakedRecipes"), UseBakedRecipes, TEXT("Map Content/BakedTables/SynthesisRecipe.mbt for the first synthesis recipe build instead of converting the data manager records. Only enable when the file is baked together with the data tables."));
+
+	int32 VerifyBakedCrc = 0;
+	FAutoConsoleVariableRef CVarVerifyBakedCrc(TEXT("MSynthesis.BakedRecipesVerifyCrc"), VerifyBakedCrc, TEXT("Check the payload checksum of the baked recipe file. Reads every mapped page."));
+}
+
+int FMSnapshotInventoryProvider::GetHaveCount(const int InTID) const
+{
+	return Snapshot.IsValid() ? Snapshot->GetCount(InTID) : 0;
+}
+
+void FMDataManagerSynthesisProvider::Build()
+{
+	BuildRecipes();
+	BuildPawns();
+}
+
+bool FMDataManagerSynthesisProvider::Refresh()
+{
+	const bool bRecipeStale = RecipeEpoch.IsStale();
+	if (bRecipeStale)
+	{
+		BuildRecipes();
+	}
+
+	if (PawnEpoch.IsStale())
+	{
+		BuildPawns();
+	}
+
+	return bRecipeStale;
+}
+
+void FMDataManagerSynthesisProvider::BuildRecipes()
+{
+	TRACE_CPUPROFILER_EVENT_SCOPE(MSynthesisProvider_BuildRecipes);
+
+	RecipeEpoch.Capture({ EMDataTable::Synthesis });
+
+	// 베이크된 파일은 부팅 때 읽는 데이터로 만들므로, 합성 테이블이 다시 읽힌 뒤에는 MDATAMGR에서 옮긴다.
+	if (MSynthesisProvider::UseBakedRecipes != 0 && FMDataEpoch::Get(EMDataTable::Synthesis) == 1)
+	{
+		FString Error;
+		if (BuildRecipesFromBaked(GetBakedRecipePath(FPaths::Combine(FPaths::ProjectContentDir(), TEXT("BakedTables"))), Error, MSynthesisProvider::VerifyBakedCrc != 0))
+		{
+			return;
+		}
+
+		UE_LOG(LogMSynthesisProvider, Log, TEXT("Baked recipes unavailable, converting data manager records. %s"), *Error);
+	}
+
+	BuildRecipesFromDataManager();
+}
+
+void FMDataManagerSynthesisProvider::BuildRecipesFromDataManager()
+{
+	TArray<TPair<int, FMSynthesisRecipe>> RecipeRecords;
+	for (const TPair<int, const FMSynthesisData*> Pair : MDATAMGR->GetSynthesisMap())
+	{
+		if (Pair.Value)
+		{
+			RecipeRecords.Emplace(Pair.Key, FMSynthesisRecipe::FromData(Pair.Key, *Pair.Value));
+		}
+	}
+	Recipes.Build(MoveTemp(RecipeRecords));
+
+	BuildRecipeIndex();
+}
+
+bool FMDataManagerSynthesisProvider::BuildRecipesFromBaked(const FString& InPath, FString& OutError, const bool bVerifyCrc)
+{
+	TMBakedTable<FMSynthesisRecipe> Baked;
+	if (Baked.Open(InPath, FMSynthesisRecipe::BakedSchemaVersion, OutError, bVerifyCrc) == false)
+	{
+		return false;
+	}
+
+	// 매핑을 들고 있지 않고 옮긴다. 합성 조회 테이블은 핫 리로드 뒤 MDATAMGR에서 다시 만드는 것과 같은 형태로 둔다.
+	Baked.CopyTo(Recipes);
+
+	BuildRecipeIndex();
+	return true;
+}
+
+FString FMDataManagerSynthesisProvider::GetBakedRecipePath(const FString& InDir)
+{
+	return FPaths::Combine(InDir, TEXT("SynthesisRecipe.mbt"));
+}
+
+void FMDataManagerSynthesisProvider::BuildRecipeIndex()
+{
+	RecipeIndexOfPawn.Reset();
+	for (int i = Recipes.Num() - 1; i >= 0; i--)
+	{
+		const FMSynthesisRecipe& Recipe = Recipes.GetRecords()[i];
+		RecipeIndexOfPawn.Emplace(GetPawnKey(Recipe.PawnType, Recipe.Grade), i);
+	}
+}
+
+void FMDataManagerSynthesisProvider::BuildPawns()
+{
+	TRACE_CPUPROFILER_EVENT_SCOPE(MSynthesisProvider_BuildPawns);
+
+	PawnEpoch.Capture({ EMDataTable::Pawn });
+
+	// 보유 중인 폰만 옮겨둔다. 이후에 새로 얻은 폰은 FindPawn에서 MDATAMGR로 찾는다.
+	TArray<TPair<int, FMSynthesisPawnInfo>> PawnRecords;
+	for (const EMPawnType Type : { EMPawnType::Hero, EMPawnType::Pet, EMPawnType::Vehicle })
+	{
+		for (const int TID : MNETDATAMGR->GetHaveNetPawnArr(Type))
+		{
+			if (const FMPawnData* PawnData = MDATAMGR->GetPawnData(TID))
+			{
+				FMSynthesisPawnInfo& Info = PawnRecords.Emplace_GetRef(TID, FMSynthesisPawnInfo()).Value;
+				Info.PawnType = static_cast<int>(PawnData->PawnType);
+				Info.Grade = static_cast<int>(PawnData->Grade);
+			}
+		}
+	}
+	Pawns.Build(MoveTemp(PawnRecords));
+}
+
+bool FMDataManagerSynthesisProvider::FindPawn(const int InTID, FMSynthesisPawnInfo& OutPawn) const
+{
+	if (const FMSynthesisPawnInfo* Info = Pawns.Find(InTID))
+	{
+		OutPawn = *Info;
+		return true;
+	}
+
+	if (const FMPawnData* PawnData = MDATAMGR->GetPawnData(InTID))
+	{
+		OutPawn.PawnType = static_cast<int>(PawnData->PawnType);
+		OutPawn.Grade = static_cast<int>(PawnData->Grade);
+		return true;
+	}
+
+	return false;
+}
+
+const FMSynthesisRecipe* FMDataManagerSynthesisProvider::FindRecipe(const int InSynthesisTID) const
+{
+	return Recipes.Find(InSynthesisTID);
+}
+
+const FMSynthesisRecipe* FMDataManagerSynthesisProvider::FindRecipeOfPawn(const FMSynthesisPawnInfo& InPawn) const
+{
+	const int* Index = RecipeIndexOfPawn.Find(GetPawnKey(InPawn.PawnType, InPawn.Grade));
+	return Index ? &Recipes.GetRecords()[*Index] : nullptr;
+}
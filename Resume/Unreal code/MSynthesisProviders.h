@@ -0,0 +1,81 @@
+/***********************************************************************************
+ *                                                                                 *
+ * Copyright. (C) 2023 Mobirix.                                                    *
+ * Website: https://mobirix.com													   *
+ *                                                                                 *
+ ***********************************************************************************/
+
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Data/MDataEpoch.h"
+#include "Data/MDenseTIDTable.h"
+#include "Synthesis/MSynthesisModel.h"
+
+struct FMPawnInventorySnapshot;
+
+// 합성 모델에 게임의 보유 수량 스냅샷을 연결한다.
+class MRPG_API FMSnapshotInventoryProvider : public IMSynthesisInventoryProvider
+{
+public:
+	virtual int GetHaveCount(const int InTID) const override;
+
+	void SetSnapshot(const TSharedPtr<const FMPawnInventorySnapshot>& InSnapshot) { Snapshot = InSnapshot; }
+
+private:
+	TSharedPtr<const FMPawnInventorySnapshot> Snapshot;
+};
+
+// 합성 모델에 MDATAMGR의 폰/합성 데이터를 연결한다.
+// 합성 데이터와 보유 폰의 종류/등급은 Build 시점에 TID 조회 테이블로 옮겨두고 MDATAMGR 조회 없이 찾는다.
+// 두 조회 테이블은 각자의 테이블 세대로 따로 무효화된다.
+// MSynthesis.BakedRecipes를 켜면 합성 테이블을 처음 만들 때 베이크된 파일을 매핑해 옮긴다.
+class MRPG_API FMDataManagerSynthesisProvider : public IMSynthesisDataProvider
+{
+public:
+	void Build();
+
+	// 다시 읽힌 테이블의 조회 테이블만 다시 만든다. 합성 조회 테이블을 다시 만들었으면 true
+	bool Refresh();
+
+	void BuildRecipesFromDataManager();
+
+	// 파일이 없거나 스키마/크기가 맞지 않으면 false
+	bool BuildRecipesFromBaked(const FString& InPath, FString& OutError, const bool bVerifyCrc = false);
+
+	static FString GetBakedRecipePath(const FString& InDir);
+
+	virtual bool FindPawn(const int InTID, FMSynthesisPawnInfo& OutPawn) const override;
+
+	virtual const FMSynthesisRecipe* FindRecipe(const int InSynthesisTID) const override;
+
+	virtual const FMSynthesisRecipe* FindRecipeOfPawn(const FMSynthesisPawnInfo& InPawn) const override;
+
+	const TMDenseTIDTable<FMSynthesisRecipe>& GetRecipes() const { return Recipes; }
+
+	// 폰/합성 테이블이 다시 읽혀 Refresh를 해야 하는지
+	bool IsStale() const { return RecipeEpoch.IsStale() || PawnEpoch.IsStale(); }
+
+	SIZE_T GetAllocatedSize() const { return Recipes.GetAllocatedSize() + RecipeIndexOfPawn.GetAllocatedSize() + Pawns.GetAllocatedSize(); }
+
+private:
+	static int GetPawnKey(const int InPawnType, const int InGrade) { return (InPawnType << 8) | (InGrade & 0xFF); }
+
+	void BuildRecipes();
+
+	void BuildRecipeIndex();
+
+	void BuildPawns();
+
+	TMDenseTIDTable<FMSynthesisRecipe> Recipes;
+
+	// (폰 종류, 등급) -> Recipes 인덱스
+	TMap<int, int> RecipeIndexOfPawn;
+
+	TMDenseTIDTable<FMSynthesisPawnInfo> Pawns;
+
+	FMDataEpochStamp RecipeEpoch;
+
+	FMDataEpochStamp PawnEpoch;
+};
@@ -0,0 +1,214 @@
+/***********************************************************************************
+ *                                                                                 *
+ * Copyright. (C) 2023 Mobirix.                                                    *
+ * Website: https://mobirix.com													   *
+ *                                                                                 *
+ ***********************************************************************************/
+
+
+#include "Synthesis/MSynthesisRedDot.h"
+
+#include "Synthesis/MPawnInventorySnapshot.h"
+#include "Synthesis/MSynthesisModel.h"
+
+FMSynthesisRedDotTracker& FMSynthesisRedDotTracker::Get()
+{
+	static FMSynthesisRedDotTracker Tracker;
+	return Tracker;
+}
+
+bool FMSynthesisRedDotTracker::Rebuild(const int InPawnType, TArrayView<const int> InTIDs, TArrayView<const int> InCounts, const IMSynthesisDataProvider& InData)
+{
+	TRACE_CPUPROFILER_EVENT_SCOPE(MSynthesisRedDot_Rebuild);
+
+	const bool bHadRedDot = HasRedDot(InPawnType);
+
+	for (auto It = PawnCounts.CreateIterator(); It; ++It)
+	{
+		if (GetPawnTypeOfKey(It->Value.GroupKey) == InPawnType)
+		{
+			It.RemoveCurrent();
+		}
+	}
+
+	for (auto It = Groups.CreateIterator(); It; ++It)
+	{
+		if (GetPawnTypeOfKey(It->Key) == InPawnType)
+		{
+			It.RemoveCurrent();
+		}
+	}
+
+	PossibleGroupCounts.Remove(InPawnType);
+	BuiltPawnTypes.Add(InPawnType);
+
+	const int Num = FMath::Min(InTIDs.Num(), InCounts.Num());
+	for (int i = 0; i < Num; i++)
+	{
+		FMSynthesisPawnInfo Pawn;
+		if (InCounts[i] <= 0 || InData.FindPawn(InTIDs[i], Pawn) == false || Pawn.PawnType != InPawnType)
+		{
+			continue;
+		}
+
+		FGroup& Group = FindOrAddGroup(Pawn.PawnType, Pawn.Grade, InData);
+		Group.Surplus += FMath::Max(InCounts[i] - 1, 0);
+
+		FPawnCount& PawnCount = PawnCounts.Add(InTIDs[i]);
+		PawnCount.Count = InCounts[i];
+		PawnCount.GroupKey = GetGroupKey(Pawn.PawnType, Pawn.Grade);
+	}
+
+	int PossibleCount = 0;
+	for (TPair<int, FGroup>& Pair : Groups)
+	{
+		if (GetPawnTypeOfKey(Pair.Key) != InPawnType)
+		{
+			continue;
+		}
+
+		FGroup& Group = Pair.Value;
+		Group.bPossible = Group.MaterialCount > 0 && Group.Surplus >= Group.MaterialCount;
+		PossibleCount += Group.bPossible ? 1 : 0;
+	}
+	PossibleGroupCounts.Add(InPawnType, PossibleCount);
+
+	const bool bHasRedDot = PossibleCount > 0;
+	if (bHadRedDot == bHasRedDot)
+	{
+		return false;
+	}
+
+	OnRedDotChanged.Broadcast(InPawnType, bHasRedDot);
+	return true;
+}
+
+bool FMSynthesisRedDotTracker::Rebuild(const FMPawnInventorySnapshot& InSnapshot, const IMSynthesisDataProvider& InData)
+{
+	return Rebuild(static_cast<int>(InSnapshot.GetPawnType()), InSnapshot.GetTIDs(), InSnapshot.GetCounts(), InData);
+}
+
+bool FMSynthesisRedDotTracker::OnPawnCountChanged(const int InTID, const int InCount, const IMSynthesisDataProvider& InData)
+{
+	const int Count = FMath::Max(InCount, 0);
+
+	FPawnCount* PawnCount = PawnCounts.Find(InTID);
+	if (PawnCount == nullptr)
+	{
+		FMSynthesisPawnInfo Pawn;
+		if (Count == 0 || InData.FindPawn(InTID, Pawn) == false)
+		{
+			return false;
+		}
+
+		FindOrAddGroup(Pawn.PawnType, Pawn.Grade, InData);
+
+		PawnCount = &PawnCounts.Add(InTID);
+		PawnCount->GroupKey = GetGroupKey(Pawn.PawnType, Pawn.Grade);
+	}
+
+	const int OldCount = PawnCount->Count;
+	const int GroupKey = PawnCount->GroupKey;
+
+	if (Count == 0)
+	{
+		PawnCounts.Remove(InTID);
+	}
+	else
+	{
+		PawnCount->Count = Count;
+	}
+
+	const int Delta = FMath::Max(Count - 1, 0) - FMath::Max(OldCount - 1, 0);
+	return Delta != 0 && AddSurplus(GroupKey, Delta);
+}
+
+bool FMSynthesisRedDotTracker::ApplySnapshotDiff(const FMPawnInventorySnapshot& InOld, const FMPawnInventorySnapshot& InNew, const IMSynthesisDataProvider& InData)
+{
+	TRACE_CPUPROFILER_EVENT_SCOPE(MSynthesisRedDot_ApplySnapshotDiff);
+
+	TArray<int> ChangedTIDs;
+	InNew.GetChangedTIDs(InOld, ChangedTIDs);
+
+	bool bChanged = false;
+	for (const int TID : ChangedTIDs)
+	{
+		bChanged |= OnPawnCountChanged(TID, InNew.GetCount(TID), InData);
+	}
+
+	return bChanged;
+}
+
+bool FMSynthesisRedDotTracker::HasRedDot(const int InPawnType) const
+{
+	const int* PossibleCount = PossibleGroupCounts.Find(InPawnType);
+	return PossibleCount && *PossibleCount > 0;
+}
+
+bool FMSynthesisRedDotTracker::IsPossible(const int InPawnType, const int InGrade) const
+{
+	const FGroup* Group = Groups.Find(GetGroupKey(InPawnType, InGrade));
+	return Group && Group->bPossible;
+}
+
+void FMSynthesisRedDotTracker::Reset()
+{
+	PawnCounts.Reset();
+	Groups.Reset();
+	PossibleGroupCounts.Reset();
+	BuiltPawnTypes.Reset();
+}
+
+FMSynthesisRedDotTracker::FGroup& FMSynthesisRedDotTracker::FindOrAddGroup(const int InPawnType, const int InGrade, const IMSynthesisDataProvider& InData)
+{
+	const int GroupKey = GetGroupKey(InPawnType, InGrade);
+	if (FGroup* Group = Groups.Find(GroupKey))
+	{
+		return *Group;
+	}
+
+	FGroup& Group = Groups.Add(GroupKey);
+
+	FMSynthesisPawnInfo Pawn;
+	Pawn.PawnType = InPawnType;
+	Pawn.Grade = InGrade;
+	if (const FMSynthesisRecipe* Recipe = InData.FindRecipeOfPawn(Pawn))
+	{
+		Group.MaterialCount = Recipe->MaterialCount;
+	}
+
+	return Group;
+}
+
+bool FMSynthesisRedDotTracker::AddSurplus(const int InGroupKey, const int InDelta)
+{
+	FGroup* Group = Groups.Find(InGroupKey);
+	if (Group == nullptr)
+	{
+		return false;
+	}
+
+	Group->Surplus += InDelta;
+
+	const bool bPossible = Group->MaterialCount > 0 && Group->Surplus >= Group->MaterialCount;
+	if (bPossible == Group->bPossible)
+	{
+		return false;
+	}
+
+	Group->bPossible = bPossible;
+
+	const int PawnType = GetPawnTypeOfKey(InGroupKey);
+	int& PossibleCount = PossibleGroupCounts.FindOrAdd(PawnType);
+	const bool bHadRedDot = PossibleCount > 0;
+	PossibleCount += bPossible ? 1 : -1;
+
+	const bool bHasRedDot = PossibleCount > 0;
+	if (bHadRedDot == bHasRedDot)
+	{
+		return false;
+	}
+
+	OnRedDotChanged.Broadcast(PawnType, bHasRedDot);
+	return true;
+}
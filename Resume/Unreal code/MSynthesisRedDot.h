@@ -0,0 +1,83 @@
+/***********************************************************************************
+ *                                                                                 *
+ * Copyright. (C) 2023 Mobirix.                                                    *
+ * Website: https://mobirix.com													   *
+ *                                                                                 *
+ ***********************************************************************************/
+
+
+#pragma once
+
+#include "CoreMinimal.h"
+
+class IMSynthesisDataProvider;
+struct FMPawnInventorySnapshot;
+
+DECLARE_MULTICAST_DELEGATE_TwoParams(FMOnSynthesisRedDotChanged, const int /*InPawnType*/, const bool /*bInRedDot*/);
+
+// 합성 레드닷을 보유 수량 변화로만 갱신한다.
+// TID별 수량과 (폰 종류, 등급)별 나머지 수량을 들고 있다가, 바뀐 TID의 나머지 수량만 더하고 뺀다.
+// 등급의 나머지 수량이 합성 재료 수(MaterialCount)를 넘나들 때만 가능 여부가 바뀌고,
+// 폰 종류의 가능한 등급 수가 0과 1 사이를 오갈 때만 레드닷이 바뀐다.
+class MRPG_API FMSynthesisRedDotTracker
+{
+public:
+	static FMSynthesisRedDotTracker& Get();
+
+	// 폰 종류 하나의 보유 목록 전체로 다시 만든다. 처음 한번과 데이터 테이블이 다시 읽혔을 때만 부른다.
+	bool Rebuild(const int InPawnType, TArrayView<const int> InTIDs, TArrayView<const int> InCounts, const IMSynthesisDataProvider& InData);
+
+	bool Rebuild(const FMPawnInventorySnapshot& InSnapshot, const IMSynthesisDataProvider& InData);
+
+	// 반환값은 레드닷이 바뀌었는지
+	bool OnPawnCountChanged(const int InTID, const int InCount, const IMSynthesisDataProvider& InData);
+
+	// InNew에서 수량이 바뀐 TID만 반영한다.
+	bool ApplySnapshotDiff(const FMPawnInventorySnapshot& InOld, const FMPawnInventorySnapshot& InNew, const IMSynthesisDataProvider& InData);
+
+	bool HasRedDot(const int InPawnType) const;
+
+	bool IsPossible(const int InPawnType, const int InGrade) const;
+
+	bool IsBuilt(const int InPawnType) const { return BuiltPawnTypes.Contains(InPawnType); }
+
+	void Reset();
+
+	FMOnSynthesisRedDotChanged OnRedDotChanged;
+
+private:
+	struct FGroup
+	{
+		int Surplus = 0;
+
+		// 0이면 합성 데이터가 없는 등급
+		int MaterialCount = 0;
+
+		bool bPossible = false;
+	};
+
+	struct FPawnCount
+	{
+		int Count = 0;
+
+		int GroupKey = 0;
+	};
+
+	static int GetGroupKey(const int InPawnType, const int InGrade) { return (InPawnType << 8) | (InGrade & 0xFF); }
+
+	static int GetPawnTypeOfKey(const int InGroupKey) { return InGroupKey >> 8; }
+
+	FGroup& FindOrAddGroup(const int InPawnType, const int InGrade, const IMSynthesisDataProvider& InData);
+
+	// 반환값은 레드닷이 바뀌었는지
+	bool AddSurplus(const int InGroupKey, const int InDelta);
+
+	TMap<int, FPawnCount> PawnCounts;
+
+	TMap<int, FGroup> Groups;
+
+	// 폰 종류별 합성 가능한 등급 수
+	TMap<int, int> PossibleGroupCounts;
+
+	TSet<int> BuiltPawnTypes;
+};
@@ -0,0 +1,95 @@
+/***********************************************************************************
+ *                                                                                 *
+ * Copyright. (C) 2023 Mobirix.                                                    *
+ * Website: https://mobirix.com													   *
+ *                                                                                 *
+ ***********************************************************************************/
+
+
+#include "Synthesis/MSynthesisSimulateCommandlet.h"
+
+#include "Data/MDataManager.h"
+#include "Data/Base/MdataStruct.h"
+#include "Synthesis/MSynthesisSimulator.h"
+
+DEFINE_LOG_CATEGORY_STATIC(LogMSynthesisSimulate, Log, All);
+
+UMSynthesisSimulateCommandlet::UMSynthesisSimulateCommandlet()
+{
+	IsClient = false;
+	IsServer = false;
+	IsEditor = false;
+	LogToConsole = true;
+}
+
+int32 UMSynthesisSimulateCommandlet::Main(const FString& Params)
+{
+	FString PawnTypeString = TEXT("Hero");
+	FParse::Value(*Params, TEXT("PawnType="), PawnTypeString);
+
+	EMPawnType PawnType = EMPawnType::Hero;
+	if (PawnTypeString == TEXT("Pet"))
+	{
+		PawnType = EMPawnType::Pet;
+	}
+	else if (PawnTypeString == TEXT("Vehicle"))
+	{
+		PawnType = EMPawnType::Vehicle;
+	}
+
+	int Grade = static_cast<int>(EMGrade::Common);
+	int Surplus = 0;
+	int MaxRounds = 0;
+	int64 Chains = 1000000;
+	uint32 Seed = 0;
+	FParse::Value(*Params, TEXT("Grade="), Grade);
+	FParse::Value(*Params, TEXT("Surplus="), Surplus);
+	FParse::Value(*Params, TEXT("Rounds="), MaxRounds);
+	FParse::Value(*Params, TEXT("Chains="), Chains);
+	FParse::Value(*Params, TEXT("Seed="), Seed);
+
+	FMSynthesisSimulationConfig Config;
+	Config.bCascade = FParse::Param(*Params, TEXT("Cascade"));
+	Config.MaxRounds = MaxRounds;
+	Config.ChainCount = Chains;
+	Config.Seed = Seed;
+	Config.StartSurplusByGrade.SetNumZeroed(Grade + 1);
+	Config.StartSurplusByGrade[Grade] = Surplus;
+
+	for (const TPair<int, const FMSynthesisData*> Pair : MDATAMGR->GetSynthesisMap())
+	{
+		if (Pair.Value->PawnType == PawnType && static_cast<int>(Pair.Value->Grade) >= Grade)
+		{
+			Config.Recipes.Emplace(FMSynthesisRecipe::FromData(Pair.Key, *Pair.Value));
+		}
+	}
+
+	if (Config.Recipes.Num() <= 0 || Surplus <= 0)
+	{
+		UE_LOG(LogMSynthesisSimulate, Error, TEXT("No synthesis recipe or surplus. PawnType=%s Grade=%d Surplus=%d"), *PawnTypeString, Grade, Surplus);
+		return 1;
+	}
+
+	const FMSynthesisSimulationResult Result = FMSynthesisSimulator::Simulate(Config);
+
+	UE_LOG(LogMSynthesisSimulate, Display, TEXT("PawnType=%s Grade=%d Surplus=%d Cascade=%d Chains=%lld Seed=%u"), *PawnTypeString, Grade, Surplus, Config.bCascade ? 1 : 0, Result.ChainCount, Seed);
+	UE_LOG(LogMSynthesisSimulate, Display, TEXT("%.3f sec, %.0f chains/sec"), Result.Seconds, Result.ChainsPerSecond);
+
+	for (int i = Grade + 1; i < Result.MeanGainByGrade.Num(); i++)
+	{
+		UE_LOG(LogMSynthesisSimulate, Display, TEXT("Grade %d : mean %.4f, stddev %.4f"), i, Result.MeanGainByGrade[i], Result.StdDevGainByGrade[i]);
+
+		const TArray<int64>& Histogram = Result.GainHistogramByGrade[i];
+		for (int Count = 0; Count < Histogram.Num(); Count++)
+		{
+			if (Histogram[Count] <= 0)
+			{
+				continue;
+			}
+
+			UE_LOG(LogMSynthesisSimulate, Display, TEXT("  %s%d : %.4f%%"), Count == Histogram.Num() - 1 ? TEXT(">=") : TEXT(""), Count, Histogram[Count] * 100.0 / FMath::Max<int64>(Result.ChainCount, 1));
+		}
+	}
+
+	return 0;
+}
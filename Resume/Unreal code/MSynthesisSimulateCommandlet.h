@@ -0,0 +1,26 @@
+/***********************************************************************************
+ *                                                                                 *
+ * Copyright. (C) 2023 Mobirix.                                                    *
+ * Website: https://mobirix.com													   *
+ *                                                                                 *
+ ***********************************************************************************/
+
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Commandlets/Commandlet.h"
+#include "MSynthesisSimulateCommandlet.generated.h"
+
+// 합성 결과 시뮬레이션 커맨드렛.
+// 예) -run=MSynthesisSimulate -PawnType=Hero -Grade=1 -Surplus=300 -Chains=1000000 -Seed=1 -Cascade
+UCLASS()
+class MRPG_API UMSynthesisSimulateCommandlet : public UCommandlet
+{
+	GENERATED_BODY()
+
+public:
+	UMSynthesisSimulateCommandlet();
+
+	virtual int32 Main(const FString& Params) override;
+};
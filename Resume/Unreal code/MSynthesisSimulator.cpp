@@ -0,0 +1,173 @@
+/***********************************************************************************
+ *                                                                                 *
+ * Copyright. (C) 2023 Mobirix.                                                    *
+ * Website: https://mobirix.com													   *
+ *                                                                                 *
+ ***********************************************************************************/
+
+
+#include "Synthesis/MSynthesisSimulator.h"
+
+#include "Async/Async.h"
+#include "Async/ParallelFor.h"
+#include "Math/RandomStream.h"
+
+namespace MSynthesisSimulator
+{
+	constexpr int ChunkCount = 256;
+
+	struct FChunkResult
+	{
+		TArray<double> SumByGrade;
+
+		TArray<double> SquareSumByGrade;
+
+		TArray<TArray<int64>> HistogramByGrade;
+	};
+}
+
+FMSynthesisSimulationResult FMSynthesisSimulator::Simulate(const FMSynthesisSimulationConfig& InConfig)
+{
+	using namespace MSynthesisSimulator;
+
+	const double StartTime = FPlatformTime::Seconds();
+
+	TArray<FMSynthesisRecipe> Recipes = InConfig.Recipes;
+	Recipes.RemoveAll([ ] (const FMSynthesisRecipe& Recipe)
+	{
+		return Recipe.MaterialCount <= 0;
+	});
+	Recipes.Sort([ ] (const FMSynthesisRecipe& A, const FMSynthesisRecipe& B)
+	{
+		return A.Grade < B.Grade;
+	});
+
+	int GradeCount = InConfig.StartSurplusByGrade.Num();
+	for (const FMSynthesisRecipe& Recipe : Recipes)
+	{
+		GradeCount = FMath::Max(GradeCount, Recipe.Grade + 2);
+	}
+
+	const int HistogramCount = FMath::Max(InConfig.MaxHistogramCount, 1) + 1;
+	const int64 ChainCount = FMath::Max<int64>(InConfig.ChainCount, 0);
+
+	TArray<FChunkResult> Chunks;
+	Chunks.SetNum(ChunkCount);
+
+	ParallelFor(ChunkCount, [ & ] (const int32 ChunkIndex)
+	{
+		FChunkResult& Chunk = Chunks[ChunkIndex];
+		Chunk.SumByGrade.Init(0.0, GradeCount);
+		Chunk.SquareSumByGrade.Init(0.0, GradeCount);
+		Chunk.HistogramByGrade.SetNum(GradeCount);
+		for (TArray<int64>& Histogram : Chunk.HistogramByGrade)
+		{
+			Histogram.Init(0, HistogramCount);
+		}
+
+		const int64 Begin = ChainCount * ChunkIndex / ChunkCount;
+		const int64 End = ChainCount * (ChunkIndex + 1) / ChunkCount;
+
+		FRandomStream Stream(static_cast<int32>(HashCombine(InConfig.Seed, GetTypeHash(ChunkIndex))));
+
+		TArray<int> Counts;
+		TArray<int> Gains;
+		Counts.SetNumZeroed(GradeCount);
+		Gains.SetNumZeroed(GradeCount);
+
+		for (int64 Chain = Begin; Chain < End; Chain++)
+		{
+			for (int Grade = 0; Grade < GradeCount; Grade++)
+			{
+				Counts[Grade] = InConfig.StartSurplusByGrade.IsValidIndex(Grade) ? InConfig.StartSurplusByGrade[Grade] : 0;
+				Gains[Grade] = 0;
+			}
+
+			for (int i = 0; i < Recipes.Num(); i++)
+			{
+				const FMSynthesisRecipe& Recipe = Recipes[i];
+
+				int Rounds = Counts[Recipe.Grade] / Recipe.MaterialCount;
+				if (i == 0 && InConfig.MaxRounds > 0)
+				{
+					Rounds = FMath::Min(Rounds, InConfig.MaxRounds);
+				}
+
+				int Success = 0;
+				for (int Round = 0; Round < Rounds; Round++)
+				{
+					Success += Stream.GetFraction() < Recipe.UpgradeRate ? 1 : 0;
+				}
+
+				Counts[Recipe.Grade] -= Rounds * Recipe.MaterialCount;
+				Counts[Recipe.Grade + 1] += Success;
+				Gains[Recipe.Grade + 1] += Success;
+
+				if (InConfig.bCascade == false)
+				{
+					break;
+				}
+			}
+
+			for (int Grade = 0; Grade < GradeCount; Grade++)
+			{
+				const double Gain = Gains[Grade];
+				Chunk.SumByGrade[Grade] += Gain;
+				Chunk.SquareSumByGrade[Grade] += Gain * Gain;
+				Chunk.HistogramByGrade[Grade][FMath::Min(Gains[Grade], HistogramCount - 1)]++;
+			}
+		}
+	});
+
+	FMSynthesisSimulationResult Result;
+	Result.ChainCount = ChainCount;
+	Result.MeanGainByGrade.Init(0.0, GradeCount);
+	Result.StdDevGainByGrade.Init(0.0, GradeCount);
+	Result.GainHistogramByGrade.SetNum(GradeCount);
+
+	for (int Grade = 0; Grade < GradeCount; Grade++)
+	{
+		double Sum = 0.0;
+		double SquareSum = 0.0;
+		TArray<int64>& Histogram = Result.GainHistogramByGrade[Grade];
+		Histogram.Init(0, HistogramCount);
+
+		for (const FChunkResult& Chunk : Chunks)
+		{
+			Sum += Chunk.SumByGrade[Grade];
+			SquareSum += Chunk.SquareSumByGrade[Grade];
+			for (int i = 0; i < HistogramCount; i++)
+			{
+				Histogram[i] += Chunk.HistogramByGrade[Grade][i];
+			}
+		}
+
+		if (ChainCount > 0)
+		{
+			const double Mean = Sum / ChainCount;
+			Result.MeanGainByGrade[Grade] = Mean;
+			Result.StdDevGainByGrade[Grade] = FMath::Sqrt(FMath::Max(SquareSum / ChainCount - Mean * Mean, 0.0));
+		}
+	}
+
+	Result.Seconds = FPlatformTime::Seconds() - StartTime;
+	Result.ChainsPerSecond = Result.Seconds > 0.0 ? ChainCount / Result.Seconds : 0.0;
+
+	return Result;
+}
+
+void FMSynthesisSimulator::SimulateAsync(FMSynthesisSimulationConfig InConfig, TFunction<void(FMSynthesisSimulationResult&&)> InOnCompleted)
+{
+	Async(EAsyncExecution::ThreadPool, [ Config = MoveTemp(InConfig), OnCompleted = MoveTemp(InOnCompleted) ] () mutable
+	{
+		FMSynthesisSimulationResult Result = FMSynthesisSimulator::Simulate(Config);
+
+		AsyncTask(ENamedThreads::GameThread, [ Result = MoveTemp(Result), OnCompleted = MoveTemp(OnCompleted) ] () mutable
+		{
+			if (OnCompleted)
+			{
+				OnCompleted(MoveTemp(Result));
+			}
+		});
+	});
+}
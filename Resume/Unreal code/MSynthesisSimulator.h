@@ -0,0 +1,59 @@
+/***********************************************************************************
+ *                                                                                 *
+ * Copyright. (C) 2023 Mobirix.                                                    *
+ * Website: https://mobirix.com													   *
+ *                                                                                 *
+ ***********************************************************************************/
+
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Synthesis/MSynthesisPlanner.h"
+
+struct MRPG_API FMSynthesisSimulationConfig
+{
+	TArray<FMSynthesisRecipe> Recipes;
+
+	// 시작 시 등급별 재료로 쓸 수 있는 수량. 인덱스는 등급 값
+	TArray<int> StartSurplusByGrade;
+
+	// 시작 등급의 최대 합성 횟수. 0이면 재료가 남지 않을 때까지
+	int MaxRounds = 0;
+
+	// 합성 결과를 상위 등급 합성의 재료로 이어서 쓸지 여부
+	bool bCascade = false;
+
+	int64 ChainCount = 100000;
+
+	uint32 Seed = 0;
+
+	int MaxHistogramCount = 64;
+};
+
+struct MRPG_API FMSynthesisSimulationResult
+{
+	int64 ChainCount = 0;
+
+	// 등급별 획득 수량 평균/표준편차. 인덱스는 등급 값
+	TArray<double> MeanGainByGrade;
+
+	TArray<double> StdDevGainByGrade;
+
+	// 등급별 획득 수량 분포. [등급][획득 수량] = 체인 수, 마지막 칸은 그 이상
+	TArray<TArray<int64>> GainHistogramByGrade;
+
+	double Seconds = 0.0;
+
+	double ChainsPerSecond = 0.0;
+};
+
+// 합성 결과를 몬테카를로 방식으로 시뮬레이션한다.
+// 체인을 고정된 개수의 청크로 나누고 청크마다 시드에서 파생한 난수열을 쓰므로 스레드 수와 무관하게 결과가 같다.
+class MRPG_API FMSynthesisSimulator
+{
+public:
+	static FMSynthesisSimulationResult Simulate(const FMSynthesisSimulationConfig& InConfig);
+
+	static void SimulateAsync(FMSynthesisSimulationConfig InConfig, TFunction<void(FMSynthesisSimulationResult&&)> InOnCompleted);
+};